@@ -1,4 +1,4 @@
-QT += core gui widgets opengl openglwidgets   # << added openglwidgets
+QT += core gui widgets opengl openglwidgets network   # << added openglwidgets
 
 # (Qt-4 compatibility line can stay or be removed; harmless either way)
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
@@ -12,15 +12,62 @@ LIBS    += -lassimp
 SOURCES += \
     main.cpp \
     desktopviewer.cpp \
-    glviewport.cpp          # << NEW
+    glviewport.cpp \
+    scenedata.cpp \
+    shaders.cpp \
+    offscreenrenderer.cpp \
+    batchrenderer.cpp \
+    modelcache.cpp \
+    bvh.cpp \
+    aobake.cpp \
+    picking.cpp \
+    meshlets.cpp \
+    meshletrenderer.cpp \
+    mmapiosystem.cpp \
+    hotreload.cpp \
+    objloader.cpp \
+    renderserver.cpp \
+    catalogbundle.cpp \
+    modelindex.cpp \
+    catalogmodel.cpp \
+    cloth.cpp
 
 HEADERS += \
     desktopviewer.h \
-    glviewport.h            # << NEW
+    glviewport.h \
+    scenedata.h \
+    shaders.h \
+    offscreenrenderer.h \
+    batchrenderer.h \
+    modelcache.h \
+    parallel.h \
+    bvh.h \
+    aobake.h \
+    picking.h \
+    meshlets.h \
+    meshletrenderer.h \
+    mmapiosystem.h \
+    hotreload.h \
+    objloader.h \
+    renderserver.h \
+    catalogbundle.h \
+    modelindex.h \
+    catalogmodel.h \
+    cloth.h
 
 FORMS += \
     desktopviewer.ui
 
+# ------------------------------------------------------------------
+# Microbenchmark'lar: "make bench" bench/ projesini ayrı derleyip çalıştırır.
+# Sonuç bench/bench.json; bench/baseline.json varsa onunla karşılaştırılır.
+# GL olan makinede toplu render testi: ./loadbench --batch --filter batch
+# ------------------------------------------------------------------
+bench.commands = $(MKDIR) bench && cd bench && \
+                 $$QMAKE_QMAKE $$PWD/bench/bench.pro && $(MAKE) && \
+                 ./loadbench --json bench.json --baseline $$PWD/bench/baseline.json
+QMAKE_EXTRA_TARGETS += bench
+
 # ------------------------------------------------------------------
 # Default deployment rules (unchanged)
 # ------------------------------------------------------------------
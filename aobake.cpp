@@ -0,0 +1,133 @@
+#include "aobake.h"
+#include "modelcache.h"
+#include "parallel.h"
+#include <QElapsedTimer>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr quint32 kCacheMagic = 0x31304f41;   // "AO01"
+
+struct AoCacheHeader {
+    quint32 magic;
+    quint32 vertexCount;
+    quint32 samples;
+};
+
+// Vertex başına deterministik rastgele sayı (xorshift)
+struct Rng {
+    quint32 state;
+    explicit Rng(quint32 seed) : state(seed * 747796405u + 2891336453u) { if (!state) state = 1; }
+    float next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return (state >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+int sampleCountFor(int vertexCount)
+{
+    // Çok büyük taramalarda import süresi makul kalsın
+    return vertexCount > 500000 ? 16 : 32;
+}
+
+} // namespace
+
+std::vector<float> AmbientOcclusion::bake(const PackedScene &scene, const TriangleBVH &bvh, int samples)
+{
+    const int vertexCount = scene.vertexCount();
+    std::vector<float> ao(size_t(vertexCount), 1.0f);
+    if (bvh.isEmpty() || samples <= 0) return ao;
+
+    const float maxDistance = scene.radius * 0.5f;
+    const float bias = scene.radius * 1e-4f;
+
+    parallelFor(size_t(vertexCount), 1024, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float *v = scene.verts.data() + i * PackedScene::kFloatsPerVertex;
+            float n[3] = {v[5], v[6], v[7]};
+            const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (len < 1e-8f) continue;
+            n[0] /= len; n[1] /= len; n[2] /= len;
+
+            // Normal etrafında ortonormal taban (Duff et al.)
+            const float sign = std::copysign(1.0f, n[2]);
+            const float a = -1.0f / (sign + n[2]);
+            const float b = n[0] * n[1] * a;
+            const float t[3] = {1.0f + sign * n[0] * n[0] * a, sign * b, -sign * n[0]};
+            const float s[3] = {b, sign + n[1] * n[1] * a, -n[1]};
+
+            Ray ray;
+            ray.o[0] = v[0] + n[0] * bias;
+            ray.o[1] = v[1] + n[1] * bias;
+            ray.o[2] = v[2] + n[2] * bias;
+            ray.tMin = 0.0f;
+            ray.tMax = maxDistance;
+
+            Rng rng(quint32(i));
+            int hits = 0;
+            for (int k = 0; k < samples; ++k) {
+                // Kosinüs ağırlıklı yarım küre örneği
+                const float r1 = rng.next(), r2 = rng.next();
+                const float phi = 6.28318531f * r1;
+                const float r = std::sqrt(r2);
+                const float x = r * std::cos(phi), y = r * std::sin(phi);
+                const float z = std::sqrt(std::max(0.0f, 1.0f - r2));
+                for (int c = 0; c < 3; ++c)
+                    ray.d[c] = t[c] * x + s[c] * y + n[c] * z;
+                if (bvh.occluded(ray)) ++hits;
+            }
+            ao[i] = 1.0f - float(hits) / samples;
+        }
+    });
+    return ao;
+}
+
+bool AmbientOcclusion::loadOrBake(PackedScene &scene, const QString &modelPath, const TriangleBVH *bvh)
+{
+    const int vertexCount = scene.vertexCount();
+    if (vertexCount == 0) return false;
+    const int samples = sampleCountFor(vertexCount);
+
+    // 0. Önceden hesaplanmış (ör. katalog bundle'ından gelen)
+    if (scene.ao.size() == size_t(vertexCount)) return true;
+
+    // 1. Cache
+    QByteArray cached;
+    if (!modelPath.isEmpty() && ModelCache::load(modelPath, scene.cacheKind("ao"), cached) &&
+        cached.size() == qsizetype(sizeof(AoCacheHeader) + size_t(vertexCount) * sizeof(float))) {
+        AoCacheHeader header;
+        memcpy(&header, cached.constData(), sizeof(header));
+        if (header.magic == kCacheMagic && int(header.vertexCount) == vertexCount && int(header.samples) == samples) {
+            scene.ao.resize(size_t(vertexCount));
+            memcpy(scene.ao.data(), cached.constData() + sizeof(header), size_t(vertexCount) * sizeof(float));
+            printf("AO cache'den yüklendi (%d vertex)\n", vertexCount);
+            return true;
+        }
+    }
+
+    // 2. Bake
+    QElapsedTimer timer;
+    timer.start();
+
+    TriangleBVH localBvh;
+    if (!bvh || bvh->isEmpty()) {
+        localBvh.build(scene.verts.data(), PackedScene::kFloatsPerVertex, scene.idx.data(), scene.idx.size() / 3);
+        bvh = &localBvh;
+    }
+    const qint64 bvhMs = timer.elapsed();
+
+    scene.ao = bake(scene, *bvh, samples);
+    printf("AO bake: %d vertex x %d örnek, BVH %lld ms, toplam %lld ms\n",
+           vertexCount, samples, (long long)bvhMs, (long long)timer.elapsed());
+
+    if (!modelPath.isEmpty()) {
+        AoCacheHeader header = {kCacheMagic, quint32(vertexCount), quint32(samples)};
+        QByteArray data(reinterpret_cast<const char*>(&header), sizeof(header));
+        data.append(reinterpret_cast<const char*>(scene.ao.data()), qsizetype(scene.ao.size() * sizeof(float)));
+        ModelCache::save(modelPath, scene.cacheKind("ao"), data);
+    }
+    return true;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <QString>
+#include <vector>
+#include "scenedata.h"
+#include "bvh.h"
+
+// Import sırasında vertex başına ambient occlusion hesabı.
+// Her vertex'ten normal yönündeki yarım küreye ışınlar atılır (BVH + SSE),
+// vertex'ler tüm çekirdeklere dağıtılır. Sonuç PackedScene::ao'ya yazılır
+// ve model cache'inde saklanır - render sırasında maliyeti yok.
+namespace AmbientOcclusion
+{
+    std::vector<float> bake(const PackedScene &scene, const TriangleBVH &bvh, int samples);
+
+    // Cache'de varsa oradan, yoksa hesaplayıp cache'e yazar.
+    // bvh verilmezse (picking BVH'ı yoksa) geçici olarak kurulur.
+    bool loadOrBake(PackedScene &scene, const QString &modelPath, const TriangleBVH *bvh = nullptr);
+}
@@ -0,0 +1,233 @@
+#include "batchrenderer.h"
+#include "offscreenrenderer.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QThread>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageWriter>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Tek bir offscreen context ile sıradaki modeli alıp tüm pozları çizen thread
+class RenderWorker : public QThread
+{
+public:
+    RenderWorker(const BatchJob &job, std::atomic<int> &nextModel, std::atomic<int> &failures,
+                 QThreadPool &encoders, QSemaphore &inFlight)
+        : job(job), nextModel(nextModel), failures(failures),
+          encoders(encoders), inFlight(inFlight)
+    {
+        // Context bu thread'de kullanılacak
+        renderer.context()->moveToThread(this);
+    }
+
+protected:
+    void run() override
+    {
+        if (!renderer.initialize(job.size)) {
+            printf("Worker başlatılamadı - offscreen OpenGL 3.3 context yok\n");
+            renderer.context()->moveToThread(QCoreApplication::instance()->thread());
+            return;
+        }
+
+        Assimp::Importer importer;
+        for (;;) {
+            const int modelIdx = nextModel.fetch_add(1);
+            if (modelIdx >= job.models.size()) break;
+
+            const QString path = job.models[modelIdx];
+            QElapsedTimer timer;
+            timer.start();
+
+            PackedScene scene;
+            if (!SceneData::loadScene(importer, path, scene) || !renderer.uploadScene(scene)) {
+                printf("Batch: %s yüklenemedi\n", path.toStdString().c_str());
+                failures.fetch_add(1);
+                continue;
+            }
+            importer.FreeScene();
+            const qint64 loadMs = timer.elapsed();
+
+            const QString baseName = QFileInfo(path).completeBaseName();
+            for (int p = 0; p < job.poses.size(); ++p) {
+                const CameraPose &pose = job.poses[p];
+                const QString outPath = QString("%1/%2_%3_y%4_p%5.%6")
+                    .arg(job.outputDir, baseName)
+                    .arg(p, 2, 10, QChar('0'))
+                    .arg(qRound(pose.yaw)).arg(qRound(pose.pitch))
+                    .arg(QString::fromLatin1(job.format));
+
+                // Kodlama kuyruğu dolarsa burada bekle (bellek sınırı). İzin
+                // readback bitince alınır: halkadaki kareler sayılmaz, yoksa
+                // worker'lar ilk kareleri kodlanmadan birbirini kilitler.
+                renderer.render(pose, [this, outPath](const QImage &frame) {
+                    inFlight.acquire();
+                    encoders.start([this, frame, outPath]() {
+                        QImageWriter writer(outPath, job.format);
+                        if (frame.isNull() || !writer.write(frame)) {
+                            printf("Batch: %s yazılamadı (%s)\n", outPath.toStdString().c_str(),
+                                   writer.errorString().toStdString().c_str());
+                            failures.fetch_add(1);
+                        }
+                        inFlight.release();
+                    });
+                });
+            }
+            renderer.finish();
+
+            printf("Batch: %s -> %d poz (yükleme %lld ms, toplam %lld ms)\n",
+                   baseName.toStdString().c_str(), int(job.poses.size()),
+                   (long long)loadMs, (long long)timer.elapsed());
+            fflush(stdout);
+        }
+
+        renderer.release();
+        renderer.context()->moveToThread(QCoreApplication::instance()->thread());
+    }
+
+private:
+    const BatchJob    &job;
+    std::atomic<int>  &nextModel;
+    std::atomic<int>  &failures;
+    QThreadPool       &encoders;
+    QSemaphore        &inFlight;
+    OffscreenRenderer  renderer;
+};
+
+} // namespace
+
+BatchRenderer::BatchRenderer(const BatchJob &job) : job(job) {}
+
+QVector<CameraPose> BatchRenderer::turntablePoses(int count, float pitch, float distance)
+{
+    QVector<CameraPose> poses;
+    for (int i = 0; i < count; ++i) {
+        CameraPose pose;
+        pose.yaw = 360.0f * i / qMax(1, count);
+        pose.pitch = pitch;
+        pose.distance = distance;
+        poses.append(pose);
+    }
+    return poses;
+}
+
+bool BatchRenderer::parseArguments(const QStringList &args, BatchJob &job, QString *error)
+{
+    QCommandLineParser parser;
+    parser.addOptions({
+        {"batch", "Headless toplu render modu"},
+        {"out", "Çıktı dizini", "dir", "renders"},
+        {"size", "Çözünürlük (GxY)", "WxH", "1024x1024"},
+        {"format", "png veya webp", "format", "png"},
+        {"threads", "Render context sayısı (0 = otomatik)", "n", "0"},
+        {"turntable", "Eşit aralıklı yaw sayısı", "n", "8"},
+        {"pitch", "Turntable pitch (derece)", "deg", "10"},
+        {"distance", "Kamera mesafesi (modelRadius katı)", "k", "2.5"},
+        {"pose", "Tekil poz: yaw,pitch,distance (tekrarlanabilir)", "y,p,d"},
+    });
+    parser.addPositionalArgument("models", "Model dosyaları veya dizinler");
+
+    if (!parser.parse(args)) {
+        if (error) *error = parser.errorText();
+        return false;
+    }
+
+    const QStringList size = parser.value("size").split('x');
+    if (size.size() != 2 || size[0].toInt() <= 0 || size[1].toInt() <= 0) {
+        if (error) *error = "Geçersiz --size: " + parser.value("size");
+        return false;
+    }
+    job.size = QSize(size[0].toInt(), size[1].toInt());
+    job.outputDir = parser.value("out");
+    job.format = parser.value("format").toLatin1().toLower();
+    job.threads = parser.value("threads").toInt();
+
+    if (!QImageWriter::supportedImageFormats().contains(job.format)) {
+        if (error) *error = "Desteklenmeyen format: " + QString::fromLatin1(job.format);
+        return false;
+    }
+
+    for (const QString &spec : parser.values("pose")) {
+        const QStringList parts = spec.split(',');
+        if (parts.size() != 3) {
+            if (error) *error = "Geçersiz --pose: " + spec;
+            return false;
+        }
+        CameraPose pose;
+        pose.yaw = parts[0].toFloat();
+        pose.pitch = parts[1].toFloat();
+        pose.distance = parts[2].toFloat();
+        job.poses.append(pose);
+    }
+    if (job.poses.isEmpty())
+        job.poses = turntablePoses(parser.value("turntable").toInt(),
+                                   parser.value("pitch").toFloat(),
+                                   parser.value("distance").toFloat());
+
+    // Dizin verilirse onRefreshClicked ile aynı filtreler
+    const QStringList filters = {"*.obj", "*.glb", "*.fbx"};
+    for (const QString &arg : parser.positionalArguments()) {
+        QFileInfo info(arg);
+        if (info.isDir()) {
+            for (const QFileInfo &file : QDir(arg).entryInfoList(filters, QDir::Files))
+                job.models.append(file.absoluteFilePath());
+        } else {
+            job.models.append(info.absoluteFilePath());
+        }
+    }
+    if (job.models.isEmpty()) {
+        if (error) *error = "Model dosyası verilmedi";
+        return false;
+    }
+    return true;
+}
+
+int BatchRenderer::run()
+{
+    QDir().mkpath(job.outputDir);
+
+    const int cores = QThread::idealThreadCount();
+    int workerCount = job.threads > 0 ? job.threads : qMax(1, cores / 2);
+    workerCount = qMin(workerCount, int(job.models.size()));
+
+    // Kodlama ayrı havuzda - render thread'leri PNG sıkıştırmayı beklemez
+    QThreadPool encoders;
+    encoders.setMaxThreadCount(qMax(1, cores - workerCount));
+    QSemaphore inFlight(qMax(4, encoders.maxThreadCount() * 2));
+
+    std::atomic<int> nextModel{0};
+    std::atomic<int> failures{0};
+
+    printf("Batch render: %d model x %d poz, %dx%d, %d render context, %d encoder\n",
+           int(job.models.size()), int(job.poses.size()),
+           job.size.width(), job.size.height(), workerCount, encoders.maxThreadCount());
+    fflush(stdout);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // OffscreenRenderer (QOffscreenSurface) GUI thread'de oluşturulmalı
+    std::vector<std::unique_ptr<RenderWorker>> workers;
+    for (int i = 0; i < workerCount; ++i)
+        workers.emplace_back(new RenderWorker(job, nextModel, failures, encoders, inFlight));
+    for (auto &worker : workers)
+        worker->start();
+    for (auto &worker : workers)
+        worker->wait();
+    encoders.waitForDone();
+
+    // Hiçbir worker başlayamadıysa kalan modeller de başarısız sayılır
+    const int untouched = qMax(0, int(job.models.size()) - nextModel.load());
+    failures.fetch_add(untouched);
+
+    printf("Batch render bitti: %lld ms, %d hata\n", (long long)timer.elapsed(), failures.load());
+    fflush(stdout);
+    return failures.load();
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QSize>
+#include <QByteArray>
+#include "scenedata.h"
+
+// Headless toplu render (ürün görselleri için turntable).
+// Her worker kendi offscreen GL context'ine sahiptir; modeller worker'lar
+// arasında paylaştırılır. GPU çizimi, PBO readback ve PNG/WebP kodlama
+// (ayrı thread pool) birbiriyle örtüşür.
+struct BatchJob
+{
+    QStringList         models;
+    QVector<CameraPose> poses;
+    QSize               size = QSize(1024, 1024);
+    QString             outputDir = "renders";
+    QByteArray          format = "png";   // png / webp (Qt image plugin'ine bağlı)
+    int                 threads = 0;      // 0 = çekirdek sayısına göre
+};
+
+class BatchRenderer
+{
+public:
+    explicit BatchRenderer(const BatchJob &job);
+
+    // Komut satırından iş tanımı: --batch ... (main.cpp)
+    static bool parseArguments(const QStringList &args, BatchJob &job, QString *error);
+    static QVector<CameraPose> turntablePoses(int count, float pitch, float distance);
+
+    // GUI thread'de çağrılır, tüm işler bitene kadar bekler. Hata sayısını döner.
+    int run();
+
+private:
+    BatchJob job;
+};
@@ -0,0 +1,41 @@
+QT += core gui opengl
+QT -= widgets
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+LIBS    += -lassimp
+
+TARGET = loadbench
+
+# Fixture olarak repodaki .glb dosyaları kullanılır
+DEFINES += BENCH_FIXTURE_DIR=\\\"$$PWD/..\\\"
+INCLUDEPATH += ..
+
+# ------------------------------------------------------------------
+# Ölçülen kernel'ler uygulamayla aynı kaynaklardan derlenir
+# ------------------------------------------------------------------
+SOURCES += \
+    loadbench.cpp \
+    ../scenedata.cpp \
+    ../aobake.cpp \
+    ../bvh.cpp \
+    ../modelcache.cpp \
+    ../mmapiosystem.cpp \
+    ../objloader.cpp \
+    ../cloth.cpp \
+    ../batchrenderer.cpp \
+    ../offscreenrenderer.cpp \
+    ../shaders.cpp
+
+HEADERS += \
+    ../scenedata.h \
+    ../aobake.h \
+    ../bvh.h \
+    ../modelcache.h \
+    ../mmapiosystem.h \
+    ../objloader.h \
+    ../parallel.h \
+    ../cloth.h \
+    ../batchrenderer.h \
+    ../offscreenrenderer.h \
+    ../shaders.h
@@ -0,0 +1,497 @@
+// Yükleme hattı kernel'leri için tekrarlanabilir microbenchmark'lar.
+// Çıktı JSON; --baseline ile önceki bir çalıştırmayla karşılaştırılır ve
+// eşik üzerindeki yavaşlamalarda sıfırdan farklı çıkış kodu döner.
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QBuffer>
+#include <QImage>
+#include <QTemporaryDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "scenedata.h"
+#include "mmapiosystem.h"
+#include "objloader.h"
+#include "cloth.h"
+#include "batchrenderer.h"
+
+namespace {
+
+struct Result {
+    QString name;
+    qint64  medianNs = 0;
+    qint64  minNs = 0;
+    qint64  items = 0;     // işlenen vertex/üçgen/piksel/bayt
+};
+
+volatile size_t g_sink = 0;   // derleyici ölçülen işi silmesin
+
+int g_repeat = 7;
+std::vector<Result> g_results;
+
+void run(const QString &name, qint64 items, const std::function<void()> &fn)
+{
+    fn();   // ısınma (cache, allocator)
+
+    std::vector<qint64> samples;
+    for (int i = 0; i < g_repeat; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        fn();
+        const auto t1 = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result r;
+    r.name = name;
+    r.medianNs = samples[samples.size() / 2];
+    r.minNs = samples.front();
+    r.items = items;
+    g_results.push_back(r);
+
+    printf("%-48s %12.3f ms  (min %10.3f ms)  %10.1f M/s\n", name.toStdString().c_str(),
+           r.medianNs / 1e6, r.minNs / 1e6, r.medianNs > 0 ? items * 1e3 / r.medianNs : 0.0);
+    fflush(stdout);
+}
+
+// Düzgün ızgara: vertexCount ~ n, üçgen sayısı ~ 2n
+aiScene *makeGridScene(unsigned targetVertices)
+{
+    const unsigned side = std::max(2u, unsigned(std::sqrt(double(targetVertices))));
+    const unsigned vertexCount = side * side;
+    const unsigned faceCount = (side - 1) * (side - 1) * 2;
+
+    aiMesh *mesh = new aiMesh;
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = vertexCount;
+    mesh->mVertices = new aiVector3D[vertexCount];
+    mesh->mNormals = new aiVector3D[vertexCount];
+    mesh->mTextureCoords[0] = new aiVector3D[vertexCount];
+    mesh->mNumUVComponents[0] = 2;
+
+    for (unsigned y = 0; y < side; ++y) {
+        for (unsigned x = 0; x < side; ++x) {
+            const unsigned i = y * side + x;
+            const float u = float(x) / (side - 1), v = float(y) / (side - 1);
+            mesh->mVertices[i] = aiVector3D(u - 0.5f, std::sin(u * 6.28f) * 0.05f, v - 0.5f);
+            mesh->mNormals[i] = aiVector3D(0.0f, 1.0f, 0.0f);
+            mesh->mTextureCoords[0][i] = aiVector3D(u, v, 0.0f);
+        }
+    }
+
+    mesh->mNumFaces = faceCount;
+    mesh->mFaces = new aiFace[faceCount];
+    unsigned f = 0;
+    for (unsigned y = 0; y + 1 < side; ++y) {
+        for (unsigned x = 0; x + 1 < side; ++x) {
+            const unsigned i = y * side + x;
+            const unsigned quad[2][3] = {{i, i + side, i + 1}, {i + 1, i + side, i + side + 1}};
+            for (const auto &tri : quad) {
+                aiFace &face = mesh->mFaces[f++];
+                face.mNumIndices = 3;
+                face.mIndices = new unsigned[3]{tri[0], tri[1], tri[2]};
+            }
+        }
+    }
+
+    aiScene *scene = new aiScene;
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1]{mesh};
+    scene->mRootNode = new aiNode;
+    return scene;
+}
+
+qint64 vertexCountOf(const aiScene *scene)
+{
+    qint64 n = 0;
+    for (unsigned i = 0; i < scene->mNumMeshes; ++i) n += scene->mMeshes[i]->mNumVertices;
+    return n;
+}
+
+qint64 faceCountOf(const aiScene *scene)
+{
+    qint64 n = 0;
+    for (unsigned i = 0; i < scene->mNumMeshes; ++i) n += scene->mMeshes[i]->mNumFaces;
+    return n;
+}
+
+void benchPacking(const QString &label, const aiScene *scene)
+{
+    const qint64 vertices = vertexCountOf(scene);
+    const qint64 faces = faceCountOf(scene);
+
+    std::vector<float> verts;
+    std::vector<unsigned> idx;
+    run("interleave/" + label, vertices, [&]() {
+        SceneData::interleaveVertices(scene, verts);
+        g_sink += verts.size();
+    });
+    run("bounds/" + label, vertices, [&]() {
+        PackedScene bounds;
+        SceneData::computeBounds(scene, bounds);
+        g_sink += size_t(bounds.radius);
+    });
+    run("indices/" + label, faces, [&]() {
+        SceneData::extractIndices(scene, idx);
+        g_sink += idx.size();
+    });
+    run("instancing/" + label, vertices, [&]() {
+        PackedScene packed;
+        SceneData::buildInstancing(scene, packed);
+        g_sink += packed.instanced.verts.size();
+    });
+}
+
+// Sentetik ızgarayı tarama çıktısı gibi v/vt/vn + f a/a/a OBJ olarak yaz
+bool writeObj(const aiScene *scene, const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    const aiMesh *m = scene->mMeshes[0];
+    QByteArray text;
+    text.reserve(1 << 20);
+    auto flush = [&]() { file.write(text); text.clear(); };
+    for (unsigned i = 0; i < m->mNumVertices; ++i) {
+        text += "v " + QByteArray::number(m->mVertices[i].x, 'f', 6) + ' '
+              + QByteArray::number(m->mVertices[i].y, 'f', 6) + ' '
+              + QByteArray::number(m->mVertices[i].z, 'f', 6) + '\n';
+        if (text.size() > (1 << 20)) flush();
+    }
+    for (unsigned i = 0; i < m->mNumVertices; ++i) {
+        text += "vt " + QByteArray::number(m->mTextureCoords[0][i].x, 'f', 6) + ' '
+              + QByteArray::number(m->mTextureCoords[0][i].y, 'f', 6) + '\n';
+        text += "vn " + QByteArray::number(m->mNormals[i].x, 'f', 4) + ' '
+              + QByteArray::number(m->mNormals[i].y, 'f', 4) + ' '
+              + QByteArray::number(m->mNormals[i].z, 'f', 4) + '\n';
+        if (text.size() > (1 << 20)) flush();
+    }
+    for (unsigned f = 0; f < m->mNumFaces; ++f) {
+        text += 'f';
+        for (unsigned k = 0; k < 3; ++k) {
+            const QByteArray i = QByteArray::number(m->mFaces[f].mIndices[k] + 1);
+            text += ' ' + i + '/' + i + '/' + i;
+        }
+        text += '\n';
+        if (text.size() > (1 << 20)) flush();
+    }
+    flush();
+    return true;
+}
+
+// Aynı OBJ: Assimp (viewer bayrakları) ve paralel hızlı yol
+void benchObj(const QString &label, const aiScene *scene)
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("grid.obj");
+    if (!dir.isValid() || !writeObj(scene, path)) return;
+    const qint64 bytes = QFileInfo(path).size();
+
+    run("obj-assimp/" + label, bytes, [&]() {
+        Assimp::Importer importer;
+        MappedIOSystem::install(importer, path);
+        const aiScene *imported = importer.ReadFile(path.toStdString(), SceneData::importFlags());
+        PackedScene packed;
+        if (imported) SceneData::packMeshes(imported, packed);
+        g_sink += packed.idx.size();
+    });
+    run("obj-fast/" + label, bytes, [&]() {
+        PackedScene packed;
+        ObjLoader::load(path, packed);
+        g_sink += packed.idx.size();
+    });
+}
+
+// Izgara dikey asılı kumaş gibi: üst kenar sabit, 1 karelik (1/60 s) adım
+void benchCloth(const QString &label, const aiScene *scene)
+{
+    PackedScene packed;
+    SceneData::packMeshes(scene, packed);
+    for (size_t v = 0; v < packed.verts.size(); v += PackedScene::kFloatsPerVertex)
+        std::swap(packed.verts[v + 1], packed.verts[v + 2]);   // XZ düzlemi -> XY (dikey)
+
+    ClothSimulation cloth;
+    if (!cloth.build(packed.verts, packed.idx)) return;
+    run("cloth-step/" + label, cloth.particleCount(), [&]() {
+        cloth.step(1.0f / 60.0f);
+        g_sink += size_t(cloth.stats().threads);
+    });
+    run("cloth-normals/" + label, cloth.particleCount(), [&]() {
+        cloth.writeVertices(packed.verts);
+        g_sink += packed.verts.size();
+    });
+}
+
+// Çok worker'lı toplu render: worker başına poz sayısı readback halkasından
+// fazla, böylece kodlama kuyruğu dolar. Süre sınırını aşarsa (kilitlenme)
+// süreç sonlandırılır; eksik ya da yazılamayan kare hata sayılır.
+bool benchBatch(int models, int workers)
+{
+    QTemporaryDir dir;
+    if (!dir.isValid()) return false;
+
+    BatchJob job;
+    aiScene *scene = makeGridScene(2000);
+    for (int i = 0; i < models; ++i) {
+        const QString path = dir.filePath(QString("grid%1.obj").arg(i));
+        if (writeObj(scene, path)) job.models.append(path);
+    }
+    delete scene;
+    job.poses = BatchRenderer::turntablePoses(12, 10.0f, 2.5f);
+    job.size = QSize(128, 128);
+    job.outputDir = dir.filePath("renders");
+    job.threads = workers;
+
+    std::atomic<bool> done{false};
+    std::thread watchdog([&]() {
+        for (int i = 0; i < 1200 && !done; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (!done) {
+            fprintf(stderr, "batch: 120 s içinde bitmedi - render/kodlama kilitlendi\n");
+            std::_Exit(3);
+        }
+    });
+
+    int failures = 0;
+    const qint64 frames = qint64(job.models.size()) * job.poses.size();
+    run(QString("batch/%1x%2-w%3").arg(job.models.size()).arg(job.poses.size()).arg(workers), frames, [&]() {
+        failures += BatchRenderer(job).run();
+    });
+    done = true;
+    watchdog.join();
+
+    const qint64 written = QDir(job.outputDir).entryList(QDir::Files).size();
+    if (failures > 0 || written != frames) {
+        printf("batch: %d hata, %lld / %lld kare yazıldı\n", failures, (long long)written, (long long)frames);
+        return false;
+    }
+    return true;
+}
+
+void benchTexture(const QString &label, const QByteArray &encoded)
+{
+    QImage decoded;
+    decoded.loadFromData(encoded);
+    if (decoded.isNull()) return;
+    const qint64 pixels = qint64(decoded.width()) * decoded.height();
+
+    run("texture-decode/" + label, qint64(encoded.size()), [&]() {
+        QImage image;
+        image.loadFromData(encoded);
+        g_sink += size_t(image.width());
+    });
+    run("texture-convert-flip/" + label, pixels, [&]() {
+        QImage gl = SceneData::toGLImage(decoded);
+        g_sink += size_t(gl.sizeInBytes());
+    });
+}
+
+QByteArray syntheticPng(int size)
+{
+    QImage image(size, size, QImage::Format_RGB32);
+    for (int y = 0; y < size; ++y) {
+        QRgb *line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < size; ++x)
+            line[x] = qRgb((x * 7) & 255, (y * 3) & 255, ((x ^ y) * 5) & 255);
+    }
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return data;
+}
+
+struct ImportProfile {
+    const char *name;
+    unsigned    flags;
+};
+
+QJsonDocument toJson()
+{
+    QJsonArray results;
+    for (const Result &r : g_results) {
+        QJsonObject o;
+        o["name"] = r.name;
+        o["median_ns"] = double(r.medianNs);
+        o["min_ns"] = double(r.minNs);
+        o["items"] = double(r.items);
+        results.append(o);
+    }
+    QJsonObject root;
+    root["schema"] = 1;
+    root["repeat"] = g_repeat;
+    root["results"] = results;
+    return QJsonDocument(root);
+}
+
+// Baseline'a göre medyan süre karşılaştırması; yavaşlayan sayısını döner
+int compareWithBaseline(const QString &path, double threshold)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        printf("\nBaseline yok (%s) - karşılaştırma atlandı\n", path.toStdString().c_str());
+        return 0;
+    }
+    const QJsonArray baseline = QJsonDocument::fromJson(file.readAll()).object()["results"].toArray();
+
+    printf("\n%-48s %12s %12s %8s\n", "benchmark", "baseline ms", "şimdi ms", "oran");
+    int regressions = 0;
+    for (const Result &r : g_results) {
+        for (const QJsonValue &v : baseline) {
+            const QJsonObject o = v.toObject();
+            if (o["name"].toString() != r.name) continue;
+            const double base = o["median_ns"].toDouble();
+            if (base <= 0) break;
+            const double ratio = r.medianNs / base;
+            const bool slower = ratio > 1.0 + threshold;
+            regressions += slower ? 1 : 0;
+            printf("%-48s %12.3f %12.3f %7.2fx%s\n", r.name.toStdString().c_str(),
+                   base / 1e6, r.medianNs / 1e6, ratio, slower ? "  << YAVAŞLAMA" : "");
+            break;
+        }
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // Toplu render offscreen GL ister (QGuiApplication); ekransız makinede offscreen platform
+    bool batch = false;
+    for (int i = 1; i < argc; ++i)
+        batch = batch || strcmp(argv[i], "--batch") == 0;
+    if (batch && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    std::unique_ptr<QCoreApplication> app(batch ? new QGuiApplication(argc, argv)
+                                                : new QCoreApplication(argc, argv));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("DesktopViewer yükleme hattı microbenchmark'ları");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"fixtures", "Fixture .glb dizini", "dir", BENCH_FIXTURE_DIR},
+        {"sizes", "Sentetik mesh boyutları (vertex)", "list", "10k,1m,10m"},
+        {"repeat", "Ölçüm tekrarı", "n", "7"},
+        {"json", "Sonuçları JSON olarak yaz", "file"},
+        {"baseline", "Karşılaştırılacak önceki JSON", "file"},
+        {"threshold", "Yavaşlama eşiği (0.10 = %10)", "ratio", "0.10"},
+        {"filter", "Sadece adı bunu içeren benchmark'lar", "text"},
+        {"batch", "Toplu render testi (offscreen OpenGL 3.3 gerekir)"},
+    });
+    parser.process(*app);
+
+    g_repeat = qMax(1, parser.value("repeat").toInt());
+    const QString filter = parser.value("filter");
+    auto enabled = [&](const QString &group) { return filter.isEmpty() || group.contains(filter); };
+
+    // 1. Sentetik mesh'ler: interleave / bounds / index çıkarma
+    for (const QString &spec : parser.value("sizes").split(',', Qt::SkipEmptyParts)) {
+        QString s = spec.trimmed().toLower();
+        unsigned mult = 1;
+        if (s.endsWith('k')) { mult = 1000; s.chop(1); }
+        else if (s.endsWith('m')) { mult = 1000000; s.chop(1); }
+        const unsigned target = unsigned(s.toDouble() * mult);
+        if (target == 0 || !enabled("synthetic-" + spec)) continue;
+
+        aiScene *scene = makeGridScene(target);
+        benchPacking("synthetic-" + spec.trimmed(), scene);
+        // OBJ metni ~70 bayt/vertex - 10m'de diske yüzlerce MB yazmamak için sınır
+        if (target <= 2000000)
+            benchObj("synthetic-" + spec.trimmed(), scene);
+        delete scene;
+    }
+
+    // Kumaş adımı: hedef 50k vertex'lik gömlek, kare başına 16 ms altı
+    if (enabled("cloth")) {
+        aiScene *scene = makeGridScene(50000);
+        benchCloth("synthetic-50k", scene);
+        delete scene;
+    }
+
+    // 2. Repodaki .glb fixture'ları: packing, texture, import profilleri
+    const ImportProfile profiles[] = {
+        {"viewer", SceneData::importFlags()},
+        {"pretransform", SceneData::importFlags() | aiProcess_PreTransformVertices},
+        {"triangulate-only", aiProcess_Triangulate},
+        {"raw", 0},
+    };
+
+    const QFileInfoList fixtures = QDir(parser.value("fixtures")).entryInfoList({"*.glb"}, QDir::Files, QDir::Name);
+    if (fixtures.isEmpty())
+        printf("Fixture bulunamadı: %s\n", parser.value("fixtures").toStdString().c_str());
+
+    for (const QFileInfo &fixture : fixtures) {
+        const QString label = fixture.completeBaseName();
+        if (!enabled(label)) continue;
+        const std::string path = fixture.absoluteFilePath().toStdString();
+
+        for (const ImportProfile &profile : profiles) {
+            Assimp::Importer importer;
+            run(QString("import-%1/%2").arg(profile.name, label), fixture.size(), [&]() {
+                const aiScene *scene = importer.ReadFile(path, profile.flags);
+                g_sink += scene ? scene->mNumMeshes : 0;
+            });
+        }
+
+        // Aynı viewer bayrakları, okumalar mmap IOSystem üzerinden
+        {
+            Assimp::Importer importer;
+            MappedIOSystem::install(importer, fixture.absoluteFilePath());
+            run(QString("import-viewer-mmap/%1").arg(label), fixture.size(), [&]() {
+                const aiScene *scene = importer.ReadFile(path, SceneData::importFlags());
+                g_sink += scene ? scene->mNumMeshes : 0;
+            });
+        }
+
+        Assimp::Importer importer;
+        const aiScene *scene = importer.ReadFile(path, SceneData::importFlags());
+        if (!scene || !scene->HasMeshes()) continue;
+        benchPacking(label, scene);
+
+        for (unsigned i = 0; i < scene->mNumTextures; ++i) {
+            const aiTexture *tex = scene->mTextures[i];
+            if (tex->mHeight != 0) continue;   // sadece sıkıştırılmış (PNG/JPG)
+            benchTexture(QString("%1#%2").arg(label).arg(i),
+                         QByteArray(reinterpret_cast<const char*>(tex->pcData), int(tex->mWidth)));
+        }
+    }
+
+    // Birden çok worker, çekirdek sayısından bağımsız kilitlenme kontrolü
+    bool batchFailed = false;
+    if (batch && enabled("batch"))
+        batchFailed = !benchBatch(8, 4);
+
+    // 3. Sabit sentetik texture (fixture'lardan bağımsız karşılaştırma için)
+    if (enabled("synthetic-png"))
+        benchTexture("synthetic-png-2048", syntheticPng(2048));
+
+    if (parser.isSet("json")) {
+        QFile out(parser.value("json"));
+        if (out.open(QIODevice::WriteOnly)) {
+            out.write(toJson().toJson());
+            printf("\nSonuçlar yazıldı: %s\n", parser.value("json").toStdString().c_str());
+        }
+    }
+
+    int regressions = 0;
+    if (parser.isSet("baseline"))
+        regressions = compareWithBaseline(parser.value("baseline"), parser.value("threshold").toDouble());
+    if (regressions > 0)
+        printf("\n%d benchmark eşikten fazla yavaşladı\n", regressions);
+    return regressions > 0 || batchFailed ? 1 : 0;
+}
@@ -0,0 +1,481 @@
+#include "bvh.h"
+#include "parallel.h"
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BVH_USE_SSE 1
+#endif
+
+namespace {
+
+using Node = TriangleBVH::Node;
+using TriPack = TriangleBVH::TriPack;
+
+constexpr int    kBins = 12;
+constexpr size_t kMaxLeaf = 8;
+constexpr size_t kMinTaskSize = 4096;   // bundan küçük alt ağaçlar tek thread'de
+
+// Traversal yığını sabit boyutlu: derinlik başına en fazla bir düğüm bekler.
+// Bu derinlikten sonra SAH yerine medyan bölme - her seviye üçgenleri yarılar,
+// 32 bit üçgen sayısıyla en fazla 32 seviye daha eklenir.
+constexpr uint32_t kMaxSahDepth = 64;
+constexpr int      kTraversalStack = 128;
+static_assert(kMaxSahDepth + 32 < uint32_t(kTraversalStack), "BVH derinliği traversal yığınını aşabilir");
+
+struct BuildPrim {
+    float bmin[3], bmax[3], c[3];
+};
+
+struct Bounds {
+    float mn[3] = { FLT_MAX,  FLT_MAX,  FLT_MAX};
+    float mx[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+    void grow(const float *pmin, const float *pmax) {
+        for (int a = 0; a < 3; ++a) {
+            mn[a] = std::min(mn[a], pmin[a]);
+            mx[a] = std::max(mx[a], pmax[a]);
+        }
+    }
+    float area() const {
+        const float dx = mx[0] - mn[0], dy = mx[1] - mn[1], dz = mx[2] - mn[2];
+        if (dx < 0) return 0.0f;
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+struct BuildItem {
+    uint32_t node;
+    size_t   begin, end;
+    uint32_t depth;
+};
+
+class Builder
+{
+public:
+    Builder(const std::vector<BuildPrim> &prims, std::vector<uint32_t> &order)
+        : prims(prims), order(order) {}
+
+    // Düğüm sınırlarını hesaplar; bölünecekse true ve mid döner
+    bool split(Node &node, size_t begin, size_t end, uint32_t depth, size_t &mid) const
+    {
+        Bounds nb, cb;
+        for (size_t i = begin; i < end; ++i) {
+            const BuildPrim &p = prims[order[i]];
+            nb.grow(p.bmin, p.bmax);
+            cb.grow(p.c, p.c);
+        }
+        for (int a = 0; a < 3; ++a) {
+            node.bmin[a] = nb.mn[a];
+            node.bmax[a] = nb.mx[a];
+        }
+
+        const size_t count = end - begin;
+        if (count <= kMaxLeaf / 2) return false;
+
+        // En geniş centroid ekseni
+        int axis = 0;
+        float extent[3];
+        for (int a = 0; a < 3; ++a) extent[a] = cb.mx[a] - cb.mn[a];
+        if (extent[1] > extent[axis]) axis = 1;
+        if (extent[2] > extent[axis]) axis = 2;
+        if (extent[axis] <= 1e-12f) {
+            if (count <= kMaxLeaf) return false;
+            // Tüm centroid'ler aynı noktada - ortadan böl
+            mid = begin + count / 2;
+            return true;
+        }
+        if (depth >= kMaxSahDepth) {
+            // Dengesiz geometride SAH çok derin ağaç üretebilir - derinliği sınırla
+            if (count <= kMaxLeaf) return false;
+            return medianSplit(begin, end, axis, mid);
+        }
+
+        // Binned SAH
+        Bounds binBounds[kBins];
+        size_t binCount[kBins] = {};
+        const float scale = kBins / extent[axis];
+        auto binOf = [&](const BuildPrim &p) {
+            return std::min(kBins - 1, int((p.c[axis] - cb.mn[axis]) * scale));
+        };
+        for (size_t i = begin; i < end; ++i) {
+            const BuildPrim &p = prims[order[i]];
+            const int b = binOf(p);
+            binCount[b]++;
+            binBounds[b].grow(p.bmin, p.bmax);
+        }
+
+        float leftArea[kBins - 1];
+        size_t leftCount[kBins - 1];
+        Bounds acc;
+        size_t n = 0;
+        for (int b = 0; b < kBins - 1; ++b) {
+            acc.grow(binBounds[b].mn, binBounds[b].mx);
+            n += binCount[b];
+            leftArea[b] = acc.area();
+            leftCount[b] = n;
+        }
+
+        float bestCost = FLT_MAX;
+        int bestSplit = -1;
+        acc = Bounds();
+        n = 0;
+        for (int b = kBins - 1; b > 0; --b) {
+            acc.grow(binBounds[b].mn, binBounds[b].mx);
+            n += binCount[b];
+            if (n == 0 || leftCount[b - 1] == 0) continue;
+            const float cost = leftCount[b - 1] * leftArea[b - 1] + n * acc.area();
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+
+        const float leafCost = count * nb.area();
+        if (bestSplit < 0 || (bestCost >= leafCost && count <= kMaxLeaf)) {
+            if (count <= kMaxLeaf) return false;
+            return medianSplit(begin, end, axis, mid);
+        }
+
+        auto it = std::partition(order.begin() + begin, order.begin() + end,
+                                 [&](uint32_t t) { return binOf(prims[t]) < bestSplit; });
+        mid = size_t(it - order.begin());
+        return mid != begin && mid != end;
+    }
+
+    bool medianSplit(size_t begin, size_t end, int axis, size_t &mid) const
+    {
+        mid = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                         [&](uint32_t a, uint32_t b) { return prims[a].c[axis] < prims[b].c[axis]; });
+        return true;
+    }
+
+    void makeLeaf(Node &node, size_t begin, size_t end) const
+    {
+        node.leftFirst = uint32_t(begin);   // şimdilik order index'i, paketlerken düzelir
+        node.count = uint32_t(end - begin);
+    }
+
+    // Tek thread'de alt ağaç (explicit stack); ulaşılan en büyük derinliği döner
+    uint32_t buildSubtree(std::vector<Node> &nodes, uint32_t root, size_t begin, size_t end, uint32_t depth) const
+    {
+        uint32_t maxDepth = depth;
+        std::vector<BuildItem> stack{{root, begin, end, depth}};
+        while (!stack.empty()) {
+            const BuildItem item = stack.back();
+            stack.pop_back();
+            maxDepth = std::max(maxDepth, item.depth);
+
+            size_t mid = 0;
+            if (!split(nodes[item.node], item.begin, item.end, item.depth, mid)) {
+                makeLeaf(nodes[item.node], item.begin, item.end);
+                continue;
+            }
+
+            const uint32_t left = uint32_t(nodes.size());
+            nodes.push_back(Node());
+            nodes.push_back(Node());
+            nodes[item.node].leftFirst = left;
+            nodes[item.node].count = 0;
+            stack.push_back({left + 1, mid, item.end, item.depth + 1});
+            stack.push_back({left, item.begin, mid, item.depth + 1});
+        }
+        return maxDepth;
+    }
+
+private:
+    const std::vector<BuildPrim> &prims;
+    std::vector<uint32_t> &order;
+};
+
+inline float slabEntry(const Node &n, const float *o, const float *inv, float tMin, float tMax)
+{
+    float t0 = tMin, t1 = tMax;
+    for (int a = 0; a < 3; ++a) {
+        float tn = (n.bmin[a] - o[a]) * inv[a];
+        float tf = (n.bmax[a] - o[a]) * inv[a];
+        if (tn > tf) std::swap(tn, tf);
+        t0 = tn > t0 ? tn : t0;
+        t1 = tf < t1 ? tf : t1;
+        if (t0 > t1) return FLT_MAX;
+    }
+    return t0;
+}
+
+// Möller-Trumbore, 4 üçgen birden. Kesişen şeritlerin bit maskesini döner.
+inline int intersectPack(const TriPack &p, const Ray &ray, float tMax,
+                         float tOut[4], float uOut[4], float vOut[4])
+{
+#ifdef BVH_USE_SSE
+    const __m128 dx = _mm_set1_ps(ray.d[0]), dy = _mm_set1_ps(ray.d[1]), dz = _mm_set1_ps(ray.d[2]);
+    const __m128 e1x = _mm_load_ps(p.e1x), e1y = _mm_load_ps(p.e1y), e1z = _mm_load_ps(p.e1z);
+    const __m128 e2x = _mm_load_ps(p.e2x), e2y = _mm_load_ps(p.e2y), e2z = _mm_load_ps(p.e2z);
+
+    // p = d x e2
+    const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+    const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+    const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+    const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+    const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+    // s = o - v0
+    const __m128 sx = _mm_sub_ps(_mm_set1_ps(ray.o[0]), _mm_load_ps(p.v0x));
+    const __m128 sy = _mm_sub_ps(_mm_set1_ps(ray.o[1]), _mm_load_ps(p.v0y));
+    const __m128 sz = _mm_sub_ps(_mm_set1_ps(ray.o[2]), _mm_load_ps(p.v0z));
+    const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inv);
+
+    // q = s x e1
+    const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+    const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+    const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+    const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inv);
+    const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inv);
+
+    const __m128 absDet = _mm_andnot_ps(_mm_set1_ps(-0.0f), det);
+    __m128 mask = _mm_cmpgt_ps(absDet, _mm_set1_ps(1e-12f));
+    mask = _mm_and_ps(mask, _mm_cmpge_ps(u, _mm_setzero_ps()));
+    mask = _mm_and_ps(mask, _mm_cmpge_ps(v, _mm_setzero_ps()));
+    mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f)));
+    mask = _mm_and_ps(mask, _mm_cmpgt_ps(t, _mm_set1_ps(ray.tMin)));
+    mask = _mm_and_ps(mask, _mm_cmplt_ps(t, _mm_set1_ps(tMax)));
+
+    _mm_storeu_ps(tOut, t);
+    _mm_storeu_ps(uOut, u);
+    _mm_storeu_ps(vOut, v);
+    return _mm_movemask_ps(mask);
+#else
+    int mask = 0;
+    for (int k = 0; k < 4; ++k) {
+        const float px = ray.d[1] * p.e2z[k] - ray.d[2] * p.e2y[k];
+        const float py = ray.d[2] * p.e2x[k] - ray.d[0] * p.e2z[k];
+        const float pz = ray.d[0] * p.e2y[k] - ray.d[1] * p.e2x[k];
+        const float det = p.e1x[k] * px + p.e1y[k] * py + p.e1z[k] * pz;
+        if (std::fabs(det) <= 1e-12f) continue;
+        const float inv = 1.0f / det;
+        const float sx = ray.o[0] - p.v0x[k], sy = ray.o[1] - p.v0y[k], sz = ray.o[2] - p.v0z[k];
+        const float u = (sx * px + sy * py + sz * pz) * inv;
+        if (u < 0.0f || u > 1.0f) continue;
+        const float qx = sy * p.e1z[k] - sz * p.e1y[k];
+        const float qy = sz * p.e1x[k] - sx * p.e1z[k];
+        const float qz = sx * p.e1y[k] - sy * p.e1x[k];
+        const float v = (ray.d[0] * qx + ray.d[1] * qy + ray.d[2] * qz) * inv;
+        if (v < 0.0f || u + v > 1.0f) continue;
+        const float t = (p.e2x[k] * qx + p.e2y[k] * qy + p.e2z[k] * qz) * inv;
+        if (t <= ray.tMin || t >= tMax) continue;
+        tOut[k] = t; uOut[k] = u; vOut[k] = v;
+        mask |= 1 << k;
+    }
+    return mask;
+#endif
+}
+
+} // namespace
+
+void TriangleBVH::clear()
+{
+    nodes.clear();
+    packs.clear();
+}
+
+void TriangleBVH::build(const float *verts, int stride, const unsigned *idx, size_t triangleCount)
+{
+    clear();
+    if (triangleCount == 0) return;
+
+    // Üçgen sınırları ve centroid'ler (paralel)
+    std::vector<BuildPrim> prims(triangleCount);
+    parallelFor(triangleCount, 16384, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            BuildPrim &p = prims[t];
+            const float *a = verts + size_t(idx[t * 3 + 0]) * stride;
+            const float *b = verts + size_t(idx[t * 3 + 1]) * stride;
+            const float *c = verts + size_t(idx[t * 3 + 2]) * stride;
+            for (int k = 0; k < 3; ++k) {
+                p.bmin[k] = std::min(a[k], std::min(b[k], c[k]));
+                p.bmax[k] = std::max(a[k], std::max(b[k], c[k]));
+                p.c[k] = (p.bmin[k] + p.bmax[k]) * 0.5f;
+            }
+        }
+    });
+
+    std::vector<uint32_t> order(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) order[t] = uint32_t(t);
+
+    Builder builder(prims, order);
+    nodes.reserve(triangleCount * 2 / (kMaxLeaf / 2) + 1);
+    nodes.push_back(Node());
+
+    // Üst seviyeler tek thread'de, yeterince alt ağaç çıkınca paralel
+    const size_t targetTasks = size_t(std::max(1, QThread::idealThreadCount())) * 4;
+    std::deque<BuildItem> pending{{0, 0, triangleCount, 0}};
+    std::vector<BuildItem> tasks;
+    uint32_t depth = 0;
+    while (!pending.empty()) {
+        const BuildItem item = pending.front();
+        pending.pop_front();
+        depth = std::max(depth, item.depth);
+
+        if (item.end - item.begin < kMinTaskSize || pending.size() + tasks.size() >= targetTasks) {
+            tasks.push_back(item);
+            continue;
+        }
+
+        size_t mid = 0;
+        if (!builder.split(nodes[item.node], item.begin, item.end, item.depth, mid)) {
+            builder.makeLeaf(nodes[item.node], item.begin, item.end);
+            continue;
+        }
+        const uint32_t left = uint32_t(nodes.size());
+        nodes.push_back(Node());
+        nodes.push_back(Node());
+        nodes[item.node].leftFirst = left;
+        nodes[item.node].count = 0;
+        pending.push_back({left, item.begin, mid, item.depth + 1});
+        pending.push_back({left + 1, mid, item.end, item.depth + 1});
+    }
+
+    std::vector<std::vector<Node>> subtrees(tasks.size());
+    std::vector<uint32_t> depths(tasks.size(), 0);
+    parallelFor(tasks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            subtrees[i].push_back(Node());
+            depths[i] = builder.buildSubtree(subtrees[i], 0, tasks[i].begin, tasks[i].end, tasks[i].depth);
+        }
+    });
+    for (uint32_t d : depths) depth = std::max(depth, d);
+    Q_ASSERT(depth < uint32_t(kTraversalStack));
+
+    // Alt ağaçları birleştir: yerel index j -> offset + j - 1 (kök yerinde kalır)
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        const std::vector<Node> &local = subtrees[i];
+        const uint32_t offset = uint32_t(nodes.size());
+        for (size_t j = 0; j < local.size(); ++j) {
+            Node n = local[j];
+            if (n.count == 0) n.leftFirst = n.leftFirst + offset - 1;
+            if (j == 0) nodes[tasks[i].node] = n;
+            else nodes.push_back(n);
+        }
+    }
+
+    // Yaprak üçgenlerini 4'lü SoA paketlere dök
+    for (Node &n : nodes) {
+        if (n.count == 0) continue;
+        const uint32_t first = n.leftFirst;
+        n.leftFirst = uint32_t(packs.size());
+        for (uint32_t k = 0; k < n.count; k += 4) {
+            TriPack pack = {};
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                pack.id[lane] = UINT32_MAX;
+                if (k + lane >= n.count) continue;   // boş şerit: dejenere, hiç kesişmez
+                const uint32_t t = order[first + k + lane];
+                const float *a = verts + size_t(idx[t * 3 + 0]) * stride;
+                const float *b = verts + size_t(idx[t * 3 + 1]) * stride;
+                const float *c = verts + size_t(idx[t * 3 + 2]) * stride;
+                pack.v0x[lane] = a[0];        pack.v0y[lane] = a[1];        pack.v0z[lane] = a[2];
+                pack.e1x[lane] = b[0] - a[0]; pack.e1y[lane] = b[1] - a[1]; pack.e1z[lane] = b[2] - a[2];
+                pack.e2x[lane] = c[0] - a[0]; pack.e2y[lane] = c[1] - a[1]; pack.e2z[lane] = c[2] - a[2];
+                pack.id[lane] = t;
+            }
+            packs.push_back(pack);
+        }
+    }
+}
+
+template<bool AnyHit>
+bool TriangleBVH::traverse(const Ray &ray, RayHit &hit) const
+{
+    if (nodes.empty()) return false;
+
+    float inv[3];
+    for (int a = 0; a < 3; ++a) {
+        const float d = std::fabs(ray.d[a]) > 1e-20f ? ray.d[a] : std::copysign(1e-20f, ray.d[a]);
+        inv[a] = 1.0f / d;
+    }
+
+    float tBest = ray.tMax;
+    bool found = false;
+    uint32_t bestPack = 0;
+    int bestLane = 0;
+    if (slabEntry(nodes[0], ray.o, inv, ray.tMin, tBest) == FLT_MAX) return false;
+
+    uint32_t stack[kTraversalStack];
+    int sp = 0;
+    uint32_t current = 0;
+    float tOut[4], uOut[4], vOut[4];
+
+    for (;;) {
+        const Node &n = nodes[current];
+        if (n.count > 0) {
+            const uint32_t packEnd = n.leftFirst + (n.count + 3) / 4;
+            for (uint32_t pi = n.leftFirst; pi < packEnd; ++pi) {
+                const int mask = intersectPack(packs[pi], ray, tBest, tOut, uOut, vOut);
+                if (!mask) continue;
+                for (int lane = 0; lane < 4; ++lane) {
+                    if ((mask & (1 << lane)) && tOut[lane] < tBest) {
+                        tBest = tOut[lane];
+                        hit.t = tOut[lane];
+                        hit.u = uOut[lane];
+                        hit.v = vOut[lane];
+                        hit.triangle = packs[pi].id[lane];
+                        bestPack = pi;
+                        bestLane = lane;
+                        found = true;
+                    }
+                }
+                if (AnyHit && found) return true;
+            }
+        } else {
+            uint32_t nearChild = n.leftFirst, farChild = n.leftFirst + 1;
+            float tNear = slabEntry(nodes[nearChild], ray.o, inv, ray.tMin, tBest);
+            float tFar  = slabEntry(nodes[farChild],  ray.o, inv, ray.tMin, tBest);
+            if (tFar < tNear) {
+                std::swap(nearChild, farChild);
+                std::swap(tNear, tFar);
+            }
+            if (tNear != FLT_MAX) {
+                if (tFar != FLT_MAX) {
+                    Q_ASSERT(sp < kTraversalStack);   // build derinliği sınırlar
+                    stack[sp++] = farChild;
+                }
+                current = nearChild;
+                continue;
+            }
+        }
+
+        // Yığından bir sonraki düğüm - artık daha yakın kesişim varsa atla
+        bool next = false;
+        while (sp > 0) {
+            current = stack[--sp];
+            if (slabEntry(nodes[current], ray.o, inv, ray.tMin, tBest) != FLT_MAX) {
+                next = true;
+                break;
+            }
+        }
+        if (!next) break;
+    }
+
+    if (found) {
+        // e1 x e2
+        const TriPack &p = packs[bestPack];
+        const int k = bestLane;
+        hit.normal[0] = p.e1y[k] * p.e2z[k] - p.e1z[k] * p.e2y[k];
+        hit.normal[1] = p.e1z[k] * p.e2x[k] - p.e1x[k] * p.e2z[k];
+        hit.normal[2] = p.e1x[k] * p.e2y[k] - p.e1y[k] * p.e2x[k];
+    }
+    return found;
+}
+
+bool TriangleBVH::intersect(const Ray &ray, RayHit &hit) const
+{
+    return traverse<false>(ray, hit);
+}
+
+bool TriangleBVH::occluded(const Ray &ray) const
+{
+    RayHit hit;
+    return traverse<true>(ray, hit);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cfloat>
+#include <vector>
+
+// Paketlenmiş üçgen listesi (PackedScene::verts/idx) üzerinde BVH.
+// Yapraklardaki üçgenler 4'lü SoA paketlerde tutulur; ışın-üçgen testi
+// SSE ile 4 üçgene aynı anda yapılır (SSE yoksa skaler döngü).
+struct Ray
+{
+    float o[3];
+    float d[3];
+    float tMin = 0.0f;
+    float tMax = FLT_MAX;
+};
+
+struct RayHit
+{
+    float    t = FLT_MAX;
+    uint32_t triangle = UINT32_MAX;   // PackedScene::idx içindeki üçgen sırası
+    float    u = 0.0f, v = 0.0f;      // barycentric
+    float    normal[3] = {0, 0, 0};   // geometrik normal (normalize edilmemiş)
+};
+
+class TriangleBVH
+{
+public:
+    struct Node {
+        float    bmin[3];
+        uint32_t leftFirst;   // iç düğüm: sol çocuk (sağ = sol + 1), yaprak: ilk paket
+        float    bmax[3];
+        uint32_t count;       // 0 = iç düğüm, aksi halde yapraktaki üçgen sayısı
+    };
+
+    struct alignas(16) TriPack {
+        float    v0x[4], v0y[4], v0z[4];
+        float    e1x[4], e1y[4], e1z[4];
+        float    e2x[4], e2y[4], e2z[4];
+        uint32_t id[4];
+    };
+
+    // verts: stride float aralıklı pozisyonlar, idx: üçgen index'leri
+    void build(const float *verts, int stride, const unsigned *idx, size_t triangleCount);
+    void clear();
+
+    bool isEmpty() const { return nodes.empty(); }
+    size_t nodeCount() const { return nodes.size(); }
+    size_t packCount() const { return packs.size(); }
+
+    bool intersect(const Ray &ray, RayHit &hit) const;   // en yakın kesişim
+    bool occluded(const Ray &ray) const;                 // herhangi bir kesişim
+
+    // Cache için ham veri (ModelCache)
+    std::vector<Node>    nodes;
+    std::vector<TriPack> packs;
+
+private:
+    template<bool AnyHit>
+    bool traverse(const Ray &ray, RayHit &hit) const;
+};
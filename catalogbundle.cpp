@@ -0,0 +1,405 @@
+#include "catalogbundle.h"
+#include "offscreenrenderer.h"
+#include <QCommandLineParser>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+#include <QBuffer>
+#include <QSet>
+#include <QElapsedTimer>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+constexpr char kMagic[8] = {'D', 'V', 'B', 'U', 'N', 'D', 'L', 'E'};
+
+static_assert(sizeof(CatalogBundle::Header) == 32, "bundle header düzeni");
+static_assert(sizeof(CatalogBundle::Entry) == 280, "bundle TOC düzeni");
+static_assert(sizeof(PackedScene::Instanced::Batch) == 4 * sizeof(quint32), "instance batch düzeni");
+static_assert(sizeof(PackedScene::Instanced::Source) == 3 * sizeof(quint32), "instance source düzeni");
+
+// Mesh aralıkları: {firstTriangle, triangleCount, sourceMesh, nameBytes, materialBytes} + isimler
+QByteArray encodeMeshes(const std::vector<PackedScene::MeshRange> &meshes)
+{
+    QByteArray out;
+    for (const PackedScene::MeshRange &m : meshes) {
+        const QByteArray name = m.name.toUtf8();
+        const QByteArray material = m.materialName.toUtf8();
+        const quint32 fields[5] = {m.firstTriangle, m.triangleCount, m.sourceMesh,
+                                   quint32(name.size()), quint32(material.size())};
+        out.append(reinterpret_cast<const char*>(fields), sizeof(fields));
+        out.append(name);
+        out.append(material);
+        while (out.size() % 4) out.append('\0');
+    }
+    return out;
+}
+
+bool decodeMeshes(const uchar *src, quint64 bytes, std::vector<PackedScene::MeshRange> &meshes)
+{
+    quint64 pos = 0;
+    while (pos < bytes) {
+        quint32 fields[5];
+        if (bytes - pos < sizeof(fields)) return false;
+        memcpy(fields, src + pos, sizeof(fields));
+        pos += sizeof(fields);
+        if (bytes - pos < quint64(fields[3]) + fields[4]) return false;
+
+        PackedScene::MeshRange m;
+        m.firstTriangle = fields[0];
+        m.triangleCount = fields[1];
+        m.sourceMesh = fields[2];
+        m.name = QString::fromUtf8(reinterpret_cast<const char*>(src + pos), fields[3]);
+        m.materialName = QString::fromUtf8(reinterpret_cast<const char*>(src + pos + fields[3]), fields[4]);
+        meshes.push_back(m);
+        pos = (pos + fields[3] + fields[4] + 3) & ~quint64(3);
+    }
+    return true;
+}
+
+template<class T>
+bool copyBlob(const uchar *base, const CatalogBundle::Range &range, std::vector<T> &out)
+{
+    if (range.bytes % sizeof(T)) return false;
+    out.resize(size_t(range.bytes / sizeof(T)));
+    if (range.bytes) memcpy(out.data(), base + range.offset, size_t(range.bytes));
+    return true;
+}
+
+// Sonraki blob hizalı başlasın
+void pad(QSaveFile &file)
+{
+    static const char zeros[CatalogBundle::kBlobAlignment] = {};
+    const qint64 rem = file.pos() % qint64(CatalogBundle::kBlobAlignment);
+    if (rem) file.write(zeros, qint64(CatalogBundle::kBlobAlignment) - rem);
+}
+
+CatalogBundle::Range writeBlob(QSaveFile &file, const void *data, size_t bytes)
+{
+    pad(file);
+    CatalogBundle::Range range = {quint64(file.pos()), quint64(bytes)};
+    if (bytes) file.write(static_cast<const char*>(data), qint64(bytes));
+    return range;
+}
+
+template<class T>
+CatalogBundle::Range writeBlob(QSaveFile &file, const std::vector<T> &values)
+{
+    return writeBlob(file, values.data(), values.size() * sizeof(T));
+}
+
+// Texture'ın kaynaktaki kodlanmış baytları: gömülü sıkıştırılmış texture ya da
+// diskteki dosya. Çözülünce aynı görüntüyü vermeyen aday atlanır; hiçbiri
+// uymazsa (ham gömülü texture) kayıpsız PNG'ye kodlanır.
+QByteArray encodeTexture(const aiScene *scene, const QStringList &files,
+                         const QImage &glImage, bool &reencoded)
+{
+    const auto sameImage = [&](const QByteArray &bytes) {
+        QImage image;
+        return image.loadFromData(bytes) && image.size() == glImage.size() &&
+               SceneData::toGLImage(image) == glImage;
+    };
+
+    reencoded = false;
+    for (unsigned int i = 0; scene && i < scene->mNumTextures; i++) {
+        const aiTexture *tex = scene->mTextures[i];
+        if (tex->mHeight != 0) continue;   // ham RGBA, kodlanmış hali yok
+        const QByteArray bytes(reinterpret_cast<const char*>(tex->pcData), qsizetype(tex->mWidth));
+        if (sameImage(bytes)) return bytes;
+    }
+    for (const QString &path : files) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) continue;
+        const QByteArray bytes = file.readAll();
+        if (sameImage(bytes)) return bytes;
+    }
+
+    reencoded = true;
+    QByteArray png;
+    QBuffer buffer(&png);
+    buffer.open(QIODevice::WriteOnly);
+    glImage.mirrored().save(&buffer, "PNG");
+    return png;
+}
+
+} // namespace
+
+CatalogBundle::~CatalogBundle()
+{
+    close();
+}
+
+bool CatalogBundle::open(const QString &path)
+{
+    close();
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    size = quint64(file.size());
+    data = size >= sizeof(Header) ? file.map(0, qint64(size)) : nullptr;
+    if (!data) {
+        printf("Bundle map edilemedi: %s\n", path.toStdString().c_str());
+        close();
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, data, sizeof(header));
+    const bool headerOk = memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+                          header.version == kVersion && header.fileBytes == size &&
+                          header.tocOffset % alignof(Entry) == 0 &&
+                          header.tocOffset <= size &&
+                          quint64(header.entryCount) * sizeof(Entry) <= size - header.tocOffset;
+    if (!headerOk) {
+        printf("Geçersiz bundle (sürüm/boyut uyuşmuyor): %s\n", path.toStdString().c_str());
+        close();
+        return false;
+    }
+
+    entries = reinterpret_cast<const Entry*>(data + header.tocOffset);
+    entryCount = int(header.entryCount);
+
+    // Bozuk/kesik dosyada load() sınır dışına okumasın - açılışta bir kez doğrula
+    for (int i = 0; i < entryCount; ++i) {
+        bool ok = validRange(entries[i].name);
+        for (const Range &blob : entries[i].blobs)
+            ok = ok && validRange(blob) && blob.offset % 4 == 0;
+        if (!ok) {
+            printf("Bundle TOC bozuk (kayıt %d): %s\n", i, path.toStdString().c_str());
+            close();
+            return false;
+        }
+    }
+
+#ifdef Q_OS_UNIX
+    // TOC ve isimler liste için hemen okunur; blob'lar seçildikçe sayfalanır
+    madvise(const_cast<uchar*>(data) + (header.tocOffset & ~quint64(4095)),
+            size_t(size - (header.tocOffset & ~quint64(4095))), MADV_WILLNEED);
+#endif
+
+    printf("Bundle açıldı: %s (%d model, %.1f MB)\n", path.toStdString().c_str(),
+           entryCount, size / (1024.0 * 1024.0));
+    return true;
+}
+
+void CatalogBundle::close()
+{
+    if (data) file.unmap(const_cast<uchar*>(data));
+    file.close();
+    data = nullptr;
+    size = 0;
+    entries = nullptr;
+    entryCount = 0;
+}
+
+bool CatalogBundle::validRange(const Range &range) const
+{
+    return range.offset <= size && range.bytes <= size - range.offset;
+}
+
+QString CatalogBundle::name(int index) const
+{
+    const Range &r = entries[index].name;
+    return QString::fromUtf8(reinterpret_cast<const char*>(data + r.offset), qsizetype(r.bytes));
+}
+
+QImage CatalogBundle::thumbnail(int index) const
+{
+    const Range &r = entries[index].blobs[Thumbnail];
+    QImage image;
+    if (r.bytes) image.loadFromData(data + r.offset, int(r.bytes), "PNG");
+    return image;
+}
+
+bool CatalogBundle::load(int index, PackedScene &out) const
+{
+    if (index < 0 || index >= entryCount) return false;
+    const Entry &e = entries[index];
+    out = PackedScene();
+
+    bool ok = copyBlob(data, e.blobs[Vertices], out.verts) &&
+              copyBlob(data, e.blobs[Indices], out.idx) &&
+              copyBlob(data, e.blobs[Ao], out.ao) &&
+              decodeMeshes(data + e.blobs[Meshes].offset, e.blobs[Meshes].bytes, out.meshes);
+
+    PackedScene::Instanced &inst = out.instanced;
+    ok = ok && copyBlob(data, e.blobs[InstanceVertices], inst.verts) &&
+               copyBlob(data, e.blobs[InstanceIndices], inst.idx) &&
+               copyBlob(data, e.blobs[InstanceTransforms], inst.transforms) &&
+               copyBlob(data, e.blobs[InstanceBatches], inst.batches) &&
+               copyBlob(data, e.blobs[InstanceSources], inst.sources);
+    if (!ok || out.vertexCount() != int(e.vertexCount) || out.triangleCount() != int(e.triangleCount)) {
+        printf("Bundle kaydı okunamadı: %s\n", name(index).toStdString().c_str());
+        return false;
+    }
+
+    out.boundingMin = QVector3D(e.boundsMin[0], e.boundsMin[1], e.boundsMin[2]);
+    out.boundingMax = QVector3D(e.boundsMax[0], e.boundsMax[1], e.boundsMax[2]);
+    out.center = QVector3D(e.center[0], e.center[1], e.center[2]);
+    out.radius = e.radius;
+    out.cacheVariant = "bundle";
+
+    const Range &texture = e.blobs[Texture];
+    if (texture.bytes) {
+        QImage image;
+        if (image.loadFromData(data + texture.offset, int(texture.bytes)))
+            out.texture = SceneData::toGLImage(image);
+        else
+            printf("Bundle texture'ı çözülemedi: %s\n", name(index).toStdString().c_str());
+    }
+    return true;
+}
+
+int CatalogBundle::pack(const QStringList &args)
+{
+    QCommandLineParser parser;
+    parser.addOptions({
+        {"pack", "Paketlenecek katalog dizini", "dir"},
+        {"out", "Bundle dosyası", "file", "catalog.dvb"},
+        {"thumb-size", "Thumbnail kenar uzunluğu (px)", "px", "128"},
+    });
+    if (!parser.parse(args) || !parser.isSet("pack")) {
+        fprintf(stderr, "Kullanım: --pack <katalog dizini> [--out catalog.dvb] [--thumb-size 128]\n");
+        return 2;
+    }
+
+    const QDir dir(parser.value("pack"));
+    const QFileInfoList files = dir.entryInfoList({"*.glb", "*.obj", "*.fbx"}, QDir::Files, QDir::Name);
+    if (files.isEmpty()) {
+        fprintf(stderr, "Model bulunamadı: %s\n", dir.absolutePath().toStdString().c_str());
+        return 1;
+    }
+    const int thumbSize = qBound(16, parser.value("thumb-size").toInt(), 1024);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Thumbnail'ler 2x çizilip küçültülür (kenar yumuşatma); GL yoksa thumbnail'siz
+    OffscreenRenderer renderer;
+    const bool canRender = renderer.initialize(QSize(thumbSize * 2, thumbSize * 2));
+    if (!canRender) printf("Offscreen GL yok - thumbnail'ler atlanacak\n");
+
+    QSaveFile out(parser.value("out"));
+    if (!out.open(QIODevice::WriteOnly)) {
+        fprintf(stderr, "Yazılamadı: %s\n", out.fileName().toStdString().c_str());
+        return 1;
+    }
+    Header header = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));   // sonda doldurulur
+
+    std::vector<Entry> toc;
+    QByteArray names;
+    quint64 sourceTotal = 0;
+
+    for (const QFileInfo &info : files) {
+        const QString path = info.absoluteFilePath();
+        Assimp::Importer importer;
+        PackedScene packed;
+        QStringList dependencies;
+        if (!SceneData::loadScene(importer, path, packed, &dependencies)) {
+            printf("Atlandı: %s\n", info.fileName().toStdString().c_str());
+            continue;
+        }
+
+        Entry e = {};
+        QSet<QString> materials;
+        for (const PackedScene::MeshRange &m : packed.meshes) materials.insert(m.materialName);
+        e.materialCount = quint32(materials.size());
+        if (const aiScene *scene = importer.GetScene()) {
+            // Assimp yolu: tekrar eden mesh'ler viewer'daki gibi instanced saklanır
+            SceneData::buildInstancing(scene, packed);
+            e.materialCount = scene->mNumMaterials;
+        }
+
+        e.blobs[Vertices] = writeBlob(out, packed.verts);
+        e.blobs[Indices]  = writeBlob(out, packed.idx);
+        e.blobs[Ao]       = writeBlob(out, packed.ao);
+        const QByteArray meshes = encodeMeshes(packed.meshes);
+        e.blobs[Meshes]   = writeBlob(out, meshes.constData(), size_t(meshes.size()));
+
+        const PackedScene::Instanced &inst = packed.instanced;
+        e.blobs[InstanceVertices]   = writeBlob(out, inst.verts);
+        e.blobs[InstanceIndices]    = writeBlob(out, inst.idx);
+        e.blobs[InstanceTransforms] = writeBlob(out, inst.transforms);
+        e.blobs[InstanceBatches]    = writeBlob(out, inst.batches);
+        e.blobs[InstanceSources]    = writeBlob(out, inst.sources);
+        e.instanceCount = quint32(inst.transforms.size() / 16);
+
+        if (!packed.texture.isNull()) {
+            bool reencoded = false;
+            const QByteArray bytes = encodeTexture(importer.GetScene(), dependencies, packed.texture, reencoded);
+            e.blobs[Texture] = writeBlob(out, bytes.constData(), size_t(bytes.size()));
+            e.textureWidth = quint32(packed.texture.width());
+            e.textureHeight = quint32(packed.texture.height());
+            e.textureReencoded = reencoded ? 1 : 0;
+        }
+
+        if (canRender && renderer.uploadScene(packed)) {
+            QImage thumb;
+            renderer.render(CameraPose(), [&](const QImage &frame) {
+                thumb = frame.scaled(thumbSize, thumbSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            });
+            renderer.finish();
+
+            QByteArray png;
+            QBuffer buffer(&png);
+            buffer.open(QIODevice::WriteOnly);
+            if (!thumb.isNull() && thumb.save(&buffer, "PNG"))
+                e.blobs[Thumbnail] = writeBlob(out, png.constData(), size_t(png.size()));
+        }
+
+        for (int a = 0; a < 3; ++a) {
+            e.boundsMin[a] = packed.boundingMin[a];
+            e.boundsMax[a] = packed.boundingMax[a];
+            e.center[a] = packed.center[a];
+        }
+        e.radius = packed.radius;
+        e.vertexCount = quint32(packed.vertexCount());
+        e.triangleCount = quint32(packed.triangleCount());
+        e.meshCount = quint32(packed.meshes.size());
+        e.sourceBytes = quint64(info.size());
+        e.sourceMtime = info.lastModified().toMSecsSinceEpoch();
+
+        // İsim ofseti şimdilik isim tablosuna göre, TOC yazılırken düzeltilir
+        const QByteArray name = info.fileName().toUtf8();
+        e.name = {quint64(names.size()), quint64(name.size())};
+        names.append(name);
+
+        toc.push_back(e);
+        sourceTotal += e.sourceBytes;
+        printf("[%zu/%lld] %s: %u üçgen, %u instance, texture %ux%u (%.1f KB%s)\n",
+               toc.size(), (long long)files.size(), info.fileName().toStdString().c_str(),
+               e.triangleCount, e.instanceCount, e.textureWidth, e.textureHeight,
+               e.blobs[Texture].bytes / 1024.0, e.textureReencoded ? ", PNG" : "");
+        fflush(stdout);
+    }
+    if (canRender) renderer.release();
+
+    pad(out);
+    header.tocOffset = quint64(out.pos());
+    const quint64 namesOffset = header.tocOffset + toc.size() * sizeof(Entry);
+    for (Entry &e : toc) e.name.offset += namesOffset;
+    out.write(reinterpret_cast<const char*>(toc.data()), qint64(toc.size() * sizeof(Entry)));
+    out.write(names);
+
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.entryCount = quint32(toc.size());
+    header.fileBytes = quint64(out.pos());
+    out.seek(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out.commit()) {
+        fprintf(stderr, "Bundle yazılamadı: %s\n", out.errorString().toStdString().c_str());
+        return 1;
+    }
+
+    printf("Bundle: %zu model, kaynak %.1f MB -> %.1f MB, %lld ms\n", toc.size(),
+           sourceTotal / (1024.0 * 1024.0), header.fileBytes / (1024.0 * 1024.0),
+           (long long)timer.elapsed());
+    return toc.empty() ? 1 : 0;
+}
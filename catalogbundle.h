@@ -0,0 +1,82 @@
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QImage>
+#include <QFile>
+#include "scenedata.h"
+
+// Tüm kataloğu tek dosyada taşıyan paket (.dvb). Çevrimdışı `--pack` ile
+// üretilir; viewer dosyayı bir kez mmap eder, model listesi ve yüklemeler
+// doğrudan bu bellekten gelir (model başına open/import/parse yok).
+//
+// Düzen: [Header][blob'lar, kBlobAlignment hizalı][TOC: Entry dizisi][isimler]
+// Blob'lar PackedScene dizilerinin ham (little-endian) kopyaları; texture
+// kaynağındaki kodlanmış haliyle (JPEG/PNG..., mip'ler GPU'da), thumbnail PNG.
+class CatalogBundle
+{
+public:
+    static constexpr quint32 kVersion = 2;
+    static constexpr quint64 kBlobAlignment = 256;
+
+    enum Blob {
+        Vertices, Indices, Ao, Meshes,
+        InstanceVertices, InstanceIndices, InstanceTransforms, InstanceBatches, InstanceSources,
+        Texture, Thumbnail,
+        BlobCount
+    };
+
+    struct Range {
+        quint64 offset;   // dosya başına göre
+        quint64 bytes;
+    };
+
+    struct Header {
+        char    magic[8];        // "DVBUNDLE"
+        quint32 version;
+        quint32 entryCount;
+        quint64 tocOffset;
+        quint64 fileBytes;
+    };
+
+    struct Entry {
+        Range   name;            // UTF-8, kaynak dosya adı
+        Range   blobs[BlobCount];
+        float   boundsMin[3], boundsMax[3], center[3], radius;
+        quint32 vertexCount, triangleCount, meshCount, materialCount;
+        quint32 textureWidth, textureHeight;
+        quint32 textureReencoded;   // 1: kaynak baytları bulunamadı, PNG'ye kodlandı
+        quint32 instanceCount;   // 0: tekrar eden mesh yok
+        quint64 sourceBytes;
+        qint64  sourceMtime;     // ms (epoch)
+    };
+
+    CatalogBundle() = default;
+    ~CatalogBundle();
+    CatalogBundle(const CatalogBundle &) = delete;
+    CatalogBundle &operator=(const CatalogBundle &) = delete;
+
+    bool open(const QString &path);
+    void close();
+    bool    isOpen() const { return data != nullptr; }
+    QString path()   const { return file.fileName(); }
+
+    int count() const { return entryCount; }
+    const Entry &entry(int index) const { return entries[index]; }
+    QString name(int index) const;
+    QImage  thumbnail(int index) const;
+
+    // Diziler tek memcpy ile kopyalanır; texture bundle belleğinden çözülür.
+    bool load(int index, PackedScene &out) const;
+
+    // --pack <dizin> [--out catalog.dvb]: dizindeki modelleri tek pakete yazar
+    static int pack(const QStringList &args);
+
+private:
+    bool validRange(const Range &range) const;
+
+    QFile        file;
+    const uchar *data = nullptr;
+    quint64      size = 0;
+    const Entry *entries = nullptr;
+    int          entryCount = 0;
+};
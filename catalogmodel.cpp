@@ -0,0 +1,92 @@
+#include "catalogmodel.h"
+#include "catalogbundle.h"
+#include <QPixmap>
+
+CatalogModel::CatalogModel(const CatalogBundle &bundle, QObject *parent)
+    : QAbstractListModel(parent), bundle(bundle)
+{
+}
+
+void CatalogModel::setItems(std::vector<Item> &&newItems)
+{
+    beginResetModel();
+    items = std::move(newItems);
+    icons.clear();
+    endResetModel();
+}
+
+void CatalogModel::updateInfo(const ModelIndex &modelIndex)
+{
+    for (Item &item : items) {
+        if (item.bundleIndex >= 0) continue;
+        if (const ModelInfo *known = modelIndex.find(QFileInfo(item.info.path))) item.info = *known;
+    }
+    // Proxy filtre ve sıralamayı bu sinyalle yeniden uygular
+    if (!items.empty()) emit dataChanged(index(0), index(int(items.size()) - 1));
+}
+
+int CatalogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(items.size());
+}
+
+QVariant CatalogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= int(items.size())) return QVariant();
+    const Item &item = items[size_t(index.row())];
+    const ModelInfo &info = item.info;
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return item.name;
+    case Qt::ToolTipRole:
+        return info.indexed
+            ? QString("%1 üçgen, %2 vertex, %3 mesh, %4 materyal, %5 texture (%6x%7), %8 KB")
+                  .arg(info.triangles).arg(info.vertices).arg(info.meshes).arg(info.materials)
+                  .arg(info.textures).arg(info.textureWidth).arg(info.textureHeight)
+                  .arg(info.size / 1024.0, 0, 'f', 1)
+            : QString("%1 KB (indeksleniyor)").arg(info.size / 1024.0, 0, 'f', 1);
+    case Qt::DecorationRole: {
+        if (item.bundleIndex < 0) return QVariant();
+        auto icon = icons.find(item.bundleIndex);
+        if (icon == icons.end()) {
+            const QImage thumb = bundle.thumbnail(item.bundleIndex);
+            icon = icons.insert(item.bundleIndex, thumb.isNull() ? QIcon() : QIcon(QPixmap::fromImage(thumb)));
+        }
+        return icon.value();
+    }
+    case BundleIndexRole:
+        return item.bundleIndex >= 0 ? QVariant(item.bundleIndex) : QVariant();
+    }
+    return QVariant();
+}
+
+CatalogFilter::CatalogFilter(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{
+}
+
+void CatalogFilter::setConditions(std::vector<ModelQuery::Condition> &&newConditions)
+{
+    conditions = std::move(newConditions);
+    invalidateFilter();
+}
+
+void CatalogFilter::setSortKey(ModelQuery::SortKey key)
+{
+    sortKey = key;
+    invalidate();
+}
+
+bool CatalogFilter::filterAcceptsRow(int sourceRow, const QModelIndex &) const
+{
+    const CatalogModel::Item &item = catalog()->item(sourceRow);
+    return ModelQuery::matches(item.info, item.key, conditions);
+}
+
+bool CatalogFilter::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
+    const CatalogModel::Item &a = catalog()->item(left.row());
+    const CatalogModel::Item &b = catalog()->item(right.row());
+    return ModelQuery::lessThan(a.info, a.key, b.info, b.key, sortKey);
+}
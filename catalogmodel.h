@@ -0,0 +1,62 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QSortFilterProxyModel>
+#include <QHash>
+#include <QIcon>
+#include <vector>
+#include "modelindex.h"
+
+class CatalogBundle;
+
+// Katalog listesinin modeli. Filtre/sıralama değişince öğe yeniden
+// oluşturulmaz; tooltip ve thumbnail ikonu sadece görünen satırlar için
+// data() içinde üretilir.
+class CatalogModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Role { BundleIndexRole = Qt::UserRole + 1 };
+
+    struct Item {
+        ModelInfo info;
+        QString   name;              // görünen dosya adı
+        QString   key;               // ModelQuery::nameKey - filtre ve sıralama için
+        int       bundleIndex = -1;  // bundle kaydı değilse -1
+    };
+
+    explicit CatalogModel(const CatalogBundle &bundle, QObject *parent = nullptr);
+
+    void setItems(std::vector<Item> &&items);
+    // Bundle dışı öğelerin bilgisini indeksten yeniler (satırlar korunur)
+    void updateInfo(const ModelIndex &modelIndex);
+    const Item &item(int row) const { return items[size_t(row)]; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    const CatalogBundle     &bundle;
+    std::vector<Item>        items;
+    mutable QHash<int, QIcon> icons;   // thumbnail PNG'si bir kez çözülür
+};
+
+// Sorgu ve sıralama anahtarı; CatalogModel üzerinde çalışır
+class CatalogFilter : public QSortFilterProxyModel
+{
+    Q_OBJECT
+public:
+    explicit CatalogFilter(QObject *parent = nullptr);
+
+    void setConditions(std::vector<ModelQuery::Condition> &&conditions);
+    void setSortKey(ModelQuery::SortKey key);
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+
+private:
+    const CatalogModel *catalog() const { return static_cast<const CatalogModel*>(sourceModel()); }
+
+    std::vector<ModelQuery::Condition> conditions;
+    ModelQuery::SortKey sortKey = ModelQuery::ByName;
+};
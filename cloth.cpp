@@ -0,0 +1,441 @@
+#include "cloth.h"
+#include "scenedata.h"
+#include "parallel.h"
+#include <QElapsedTimer>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// Uyum (compliance, ters sertlik): gerilme sıfır = uzamaz kumaş, bükülme yumuşak.
+// Değerler model birimine değil substep süresine göre ölçeklenir (XPBD).
+constexpr float kStretchCompliance = 0.0f;
+constexpr float kBendCompliance    = 5e-5f;
+constexpr float kDamping           = 1.0f;    // 1/s
+constexpr float kFriction          = 0.3f;    // gövde temasında teğetsel hız kaybı
+constexpr float kShirtHeight       = 0.7f;    // m - yerçekimini model birimine taşımak için
+
+// Bu kadar parçacığın altında thread açmak kazandırmıyor
+constexpr unsigned kParticlesPerThread = 4096;
+
+float segmentDistance(const QVector3D &p, const QVector3D &a, const QVector3D &b)
+{
+    const QVector3D ab = b - a;
+    const float len2 = QVector3D::dotProduct(ab, ab);
+    const float t = len2 > 0.0f ? qBound(0.0f, QVector3D::dotProduct(p - a, ab) / len2, 1.0f) : 0.0f;
+    return (p - (a + ab * t)).length();
+}
+
+} // namespace
+
+void ClothSimulation::clear()
+{
+    for (std::vector<float> *v : {&x, &y, &z, &px, &py, &pz, &vx, &vy, &vz, &invMass, &tetherLength,
+                                  &restLength, &compliance, &nx, &ny, &nz})
+        v->clear();
+    for (std::vector<unsigned> *v : {&tetherAnchor, &ca, &cb, &colorOffsets, &vertexParticle, &triangles,
+                                     &adjacencyOffsets, &adjacency})
+        v->clear();
+    serialBucket = -1;
+    normalSign = 1.0f;
+    capsules.clear();
+    stepStats = StepStats();
+}
+
+bool ClothSimulation::build(const std::vector<float> &verts, const std::vector<unsigned> &idx)
+{
+    clear();
+    const size_t vertexCount = verts.size() / PackedScene::kFloatsPerVertex;
+    if (vertexCount == 0 || idx.size() < 3) return false;
+
+    // 1. Aynı konumdaki render vertex'leri (UV/normal dikişleri) tek parçacık
+    std::vector<unsigned> order(vertexCount);
+    for (unsigned i = 0; i < vertexCount; ++i) order[i] = i;
+    auto position = [&](unsigned v) { return &verts[size_t(v) * PackedScene::kFloatsPerVertex]; };
+    std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) {
+        return memcmp(position(a), position(b), 3 * sizeof(float)) < 0;
+    });
+
+    vertexParticle.resize(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const float *p = position(order[i]);
+        if (i == 0 || memcmp(p, position(order[i - 1]), 3 * sizeof(float)) != 0) {
+            x.push_back(p[0]);
+            y.push_back(p[1]);
+            z.push_back(p[2]);
+        }
+        vertexParticle[order[i]] = unsigned(x.size() - 1);
+    }
+    const unsigned n = unsigned(x.size());
+
+    // 2. Parçacık indeksli üçgenler (kaynak sonrası dejenere olanlar atılır)
+    triangles.reserve(idx.size());
+    for (size_t t = 0; t + 2 < idx.size(); t += 3) {
+        if (idx[t] >= vertexCount || idx[t + 1] >= vertexCount || idx[t + 2] >= vertexCount) continue;
+        const unsigned a = vertexParticle[idx[t]], b = vertexParticle[idx[t + 1]], c = vertexParticle[idx[t + 2]];
+        if (a == b || b == c || a == c) continue;
+        triangles.insert(triangles.end(), {a, b, c});
+    }
+    if (triangles.empty()) {
+        clear();
+        return false;
+    }
+
+    // 3. Kenarlar: her benzersiz kenar mesafe kısıtı, iki üçgenin paylaştığı
+    //    kenarda karşı köşeler arası bükülme kısıtı
+    struct HalfEdge {
+        quint64  key;        // (küçük << 32) | büyük
+        unsigned opposite;
+    };
+    std::vector<HalfEdge> edges;
+    edges.reserve(triangles.size());
+    for (size_t t = 0; t < triangles.size(); t += 3) {
+        for (int k = 0; k < 3; ++k) {
+            const unsigned a = triangles[t + k], b = triangles[t + (k + 1) % 3];
+            edges.push_back({(quint64(std::min(a, b)) << 32) | std::max(a, b), triangles[t + (k + 2) % 3]});
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const HalfEdge &l, const HalfEdge &r) { return l.key < r.key; });
+
+    std::vector<unsigned> rawA, rawB;
+    std::vector<float>    rawCompliance;
+    auto addConstraint = [&](unsigned a, unsigned b, float alpha) {
+        rawA.push_back(a);
+        rawB.push_back(b);
+        rawCompliance.push_back(alpha);
+    };
+    for (size_t i = 0; i < edges.size();) {
+        size_t j = i + 1;
+        while (j < edges.size() && edges[j].key == edges[i].key) ++j;
+        addConstraint(unsigned(edges[i].key >> 32), unsigned(edges[i].key & 0xffffffffu), kStretchCompliance);
+        // Manifold olmayan kenarda (>2 üçgen) sadece ilk çift
+        if (j - i >= 2 && edges[i].opposite != edges[i + 1].opposite)
+            addConstraint(edges[i].opposite, edges[i + 1].opposite, kBendCompliance);
+        i = j;
+    }
+
+    // 4. Açgözlü boyama: aynı renkteki kısıtlar parçacık paylaşmaz -> renk içi kilitsiz
+    const size_t m = rawA.size();
+    std::vector<quint64> used(n, 0);
+    std::vector<unsigned char> color(m);
+    unsigned colorUsed[kSerialColor + 1] = {};
+    for (size_t k = 0; k < m; ++k) {
+        const quint64 busy = used[rawA[k]] | used[rawB[k]];
+        int c = kSerialColor;
+        for (int bit = 0; bit < kSerialColor; ++bit) {
+            if (!(busy & (quint64(1) << bit))) { c = bit; break; }
+        }
+        if (c != kSerialColor) {
+            used[rawA[k]] |= quint64(1) << c;
+            used[rawB[k]] |= quint64(1) << c;
+        }
+        color[k] = (unsigned char)c;
+        ++colorUsed[c];
+    }
+
+    // Boş renkler atlanır, seri kova en sona
+    int bucketOf[kSerialColor + 1];
+    colorOffsets.push_back(0);
+    for (int c = 0; c <= kSerialColor; ++c) {
+        bucketOf[c] = -1;
+        if (colorUsed[c] == 0) continue;
+        bucketOf[c] = int(colorOffsets.size()) - 1;
+        if (c == kSerialColor) serialBucket = bucketOf[c];
+        colorOffsets.push_back(colorOffsets.back() + colorUsed[c]);
+    }
+
+    ca.resize(m);
+    cb.resize(m);
+    restLength.resize(m);
+    compliance.resize(m);
+    std::vector<unsigned> cursor(colorOffsets.begin(), colorOffsets.end() - 1);
+    for (size_t k = 0; k < m; ++k) {
+        const unsigned slot = cursor[size_t(bucketOf[color[k]])]++;
+        const unsigned a = rawA[k], b = rawB[k];
+        ca[slot] = a;
+        cb[slot] = b;
+        restLength[slot] = std::sqrt((x[a] - x[b]) * (x[a] - x[b]) + (y[a] - y[b]) * (y[a] - y[b]) +
+                                     (z[a] - z[b]) * (z[a] - z[b]));
+        compliance[slot] = rawCompliance[k];
+    }
+
+    // 5. Normal için parçacık -> üçgen komşuluğu (paralel toplama, yarış yok)
+    adjacencyOffsets.assign(n + 1, 0);
+    for (unsigned p : triangles) ++adjacencyOffsets[p + 1];
+    for (unsigned i = 0; i < n; ++i) adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+    adjacency.resize(triangles.size());
+    std::vector<unsigned> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t i = 0; i < triangles.size(); ++i)
+        adjacency[fill[triangles[i]]++] = unsigned(i / 3);
+
+    // 6. Durum: hareketsiz başla, yaka bandı sabit (model "askıda" drape olur)
+    px = x; py = y; pz = z;
+    vx.assign(n, 0.0f); vy.assign(n, 0.0f); vz.assign(n, 0.0f);
+    nx.assign(n, 0.0f); ny.assign(n, 0.0f); nz.assign(n, 0.0f);
+
+    boundsMin = QVector3D(*std::min_element(x.begin(), x.end()), *std::min_element(y.begin(), y.end()),
+                          *std::min_element(z.begin(), z.end()));
+    boundsMax = QVector3D(*std::max_element(x.begin(), x.end()), *std::max_element(y.begin(), y.end()),
+                          *std::max_element(z.begin(), z.end()));
+    const float height = std::max(boundsMax.y() - boundsMin.y(), 1e-6f);
+    gravity = 9.81f * height / kShirtHeight;
+    thickness = 0.004f * height;
+
+    const float pinY = boundsMax.y() - kPinBand * height;
+    invMass.resize(n);
+    for (unsigned i = 0; i < n; ++i)
+        invMass[i] = y[i] >= pinY ? 0.0f : 1.0f;
+    buildTethers();
+
+    // Sarım yönünü kaynak normallerle hizala (ters export edilmiş giysiler içten aydınlanmasın)
+    computeNormals(0, n);
+    double agreement = 0.0;
+    for (size_t v = 0; v < vertexCount; ++v) {
+        const float *normal = position(unsigned(v)) + 5;
+        const unsigned p = vertexParticle[v];
+        agreement += nx[p] * normal[0] + ny[p] * normal[1] + nz[p] * normal[2];
+    }
+    normalSign = agreement < 0.0 ? -1.0f : 1.0f;
+
+    fitBodyProxy();
+
+    printf("Kumaş: %u vertex -> %u parçacık, %d kısıt, %d renk%s, %d kapsül\n",
+           unsigned(vertexCount), n, constraintCount(), colorCount(),
+           serialBucket >= 0 ? " (+seri)" : "", int(capsules.size()));
+    fflush(stdout);
+    return true;
+}
+
+void ClothSimulation::fitBodyProxy()
+{
+    capsules.clear();
+    if (x.empty()) return;
+
+    // Y yukarı, +Z ön varsayımı (viewer kameralarıyla aynı). İki dikey kapsül gövde,
+    // yatay kapsül omuz hattı; giysi gövdeden genişse (T-poz) kollar.
+    const QVector3D size = boundsMax - boundsMin;
+    const QVector3D c = (boundsMin + boundsMax) * 0.5f;
+    const float halfWidth = size.x() * 0.5f;
+    const float r = 0.4f * size.z();
+    const float shoulderY = boundsMax.y() - 0.12f * size.y();
+    const float torsoX = std::max(0.0f, std::min(halfWidth - r, 0.5f * r));
+    const float shoulderX = std::min(halfWidth, torsoX + 1.5f * r);
+
+    for (float side : {-1.0f, 1.0f}) {
+        capsules.push_back({QVector3D(c.x() + side * torsoX, boundsMin.y() - 0.2f * size.y(), c.z()),
+                            QVector3D(c.x() + side * torsoX, shoulderY, c.z()), r});
+        if (halfWidth > shoulderX + r) {
+            capsules.push_back({QVector3D(c.x() + side * shoulderX, shoulderY, c.z()),
+                                QVector3D(c.x() + side * (halfWidth - 0.1f * r), shoulderY - 0.1f * size.y(), c.z()),
+                                0.35f * r});
+        }
+    }
+    capsules.push_back({QVector3D(c.x() - shoulderX, shoulderY, c.z()),
+                        QVector3D(c.x() + shoulderX, shoulderY, c.z()), 0.6f * r});
+
+    // Başlangıç pozunda kumaş kapsülün içinde kalmasın: parçacıkların en yakın
+    // %2'sine göre yarıçapı küçült (aksi halde ilk karede dışarı fırlar)
+    const unsigned n = unsigned(x.size());
+    std::vector<float> distance(n);
+    for (Capsule &capsule : capsules) {
+        parallelFor(n, 8192, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                distance[i] = segmentDistance(QVector3D(x[i], y[i], z[i]), capsule.a, capsule.b);
+        });
+        auto nth = distance.begin() + std::ptrdiff_t(n / 50);
+        std::nth_element(distance.begin(), nth, distance.end());
+        capsule.radius = std::min(capsule.radius, *nth - 2.0f * thickness);
+    }
+    capsules.erase(std::remove_if(capsules.begin(), capsules.end(),
+                                  [this](const Capsule &capsule) { return capsule.radius < thickness; }),
+                   capsules.end());
+}
+
+void ClothSimulation::buildTethers()
+{
+    std::vector<unsigned> pinned;
+    for (unsigned i = 0; i < unsigned(x.size()); ++i)
+        if (invMass[i] == 0.0f) pinned.push_back(i);
+    if (pinned.empty()) return;
+
+    // Öklid mesafesi: başlangıç pozu dinlenme hali kabul edilir, kumaş boyunca
+    // (geodezik) mesafe bundan kısa olamaz -> bağ hiçbir zaman kumaşı germez
+    tetherAnchor.resize(x.size());
+    tetherLength.resize(x.size());
+    parallelFor(x.size(), 1024, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float best = std::numeric_limits<float>::max();
+            unsigned anchor = unsigned(i);
+            for (unsigned p : pinned) {
+                const float dx = x[i] - x[p], dy = y[i] - y[p], dz = z[i] - z[p];
+                const float d2 = dx * dx + dy * dy + dz * dz;
+                if (d2 < best) { best = d2; anchor = p; }
+            }
+            tetherAnchor[i] = anchor;
+            tetherLength[i] = std::sqrt(best);
+        }
+    });
+}
+
+void ClothSimulation::solveRange(unsigned begin, unsigned end, float alphaScale)
+{
+    for (unsigned k = begin; k < end; ++k) {
+        const unsigned a = ca[k], b = cb[k];
+        const float wa = invMass[a], wb = invMass[b];
+        const float w = wa + wb;
+        if (w == 0.0f) continue;
+
+        const float dx = x[a] - x[b], dy = y[a] - y[b], dz = z[a] - z[b];
+        const float len = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (len < 1e-9f) continue;
+
+        // XPBD: tek iterasyon / substep, biriken lambda tutulmaz
+        const float lambda = -(len - restLength[k]) / (w + compliance[k] * alphaScale);
+        const float s = lambda / len;
+        x[a] += wa * s * dx; y[a] += wa * s * dy; z[a] += wa * s * dz;
+        x[b] -= wb * s * dx; y[b] -= wb * s * dy; z[b] -= wb * s * dz;
+    }
+}
+
+void ClothSimulation::collideRange(unsigned begin, unsigned end)
+{
+    // Bağlar önce: çapa sabit parçacık, sadece kendi parçacığı yazılır (yarış yok)
+    if (!tetherAnchor.empty()) {
+        for (unsigned i = begin; i < end; ++i) {
+            const unsigned a = tetherAnchor[i];
+            const float dx = x[i] - x[a], dy = y[i] - y[a], dz = z[i] - z[a];
+            const float d2 = dx * dx + dy * dy + dz * dz;
+            const float limit = tetherLength[i];
+            if (d2 <= limit * limit) continue;
+            const float s = limit / std::sqrt(d2);
+            x[i] = x[a] + dx * s; y[i] = y[a] + dy * s; z[i] = z[a] + dz * s;
+        }
+    }
+
+    for (const Capsule &capsule : capsules) {
+        const float ax = capsule.a.x(), ay = capsule.a.y(), az = capsule.a.z();
+        const float abx = capsule.b.x() - ax, aby = capsule.b.y() - ay, abz = capsule.b.z() - az;
+        const float len2 = abx * abx + aby * aby + abz * abz;
+        const float invLen2 = len2 > 0.0f ? 1.0f / len2 : 0.0f;
+        const float reach = capsule.radius + thickness;
+
+        for (unsigned i = begin; i < end; ++i) {
+            const float t = qBound(0.0f, ((x[i] - ax) * abx + (y[i] - ay) * aby + (z[i] - az) * abz) * invLen2, 1.0f);
+            const float dx = x[i] - (ax + abx * t), dy = y[i] - (ay + aby * t), dz = z[i] - (az + abz * t);
+            const float d2 = dx * dx + dy * dy + dz * dz;
+            if (d2 >= reach * reach || d2 < 1e-12f || invMass[i] == 0.0f) continue;
+
+            // Yüzeye it, sonra bu substep'teki yer değiştirmenin teğetsel kısmını kırp
+            const float d = std::sqrt(d2);
+            const float nxi = dx / d, nyi = dy / d, nzi = dz / d;
+            x[i] += nxi * (reach - d); y[i] += nyi * (reach - d); z[i] += nzi * (reach - d);
+
+            const float mx = x[i] - px[i], my = y[i] - py[i], mz = z[i] - pz[i];
+            const float mn = mx * nxi + my * nyi + mz * nzi;
+            x[i] -= (mx - mn * nxi) * kFriction;
+            y[i] -= (my - mn * nyi) * kFriction;
+            z[i] -= (mz - mn * nzi) * kFriction;
+        }
+    }
+}
+
+void ClothSimulation::step(float dt)
+{
+    if (x.empty() || dt <= 0.0f) return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const unsigned n = unsigned(x.size());
+    const float h = dt / kSubsteps;
+    const float alphaScale = 1.0f / (h * h);
+    const float damping = std::max(0.0f, 1.0f - kDamping * h);
+    const size_t threads = std::max<size_t>(1, std::min<size_t>(size_t(QThread::idealThreadCount()),
+                                                                n / kParticlesPerThread));
+
+    // Thread'ler step başına bir kez açılır; aşamalar (tahmin, renkler,
+    // çarpışma) arası barrier. Parçacık döngüleri thread başına sabit dilim.
+    parallelTeam(threads, [&](size_t t, size_t count, SpinBarrier &barrier) {
+        auto slice = [&](unsigned begin, unsigned end, unsigned &from, unsigned &to) {
+            const quint64 length = end - begin;
+            from = begin + unsigned(length * t / count);
+            to = begin + unsigned(length * (t + 1) / count);
+        };
+        unsigned pb, pe;
+        slice(0, n, pb, pe);
+
+        for (int s = 0; s < kSubsteps; ++s) {
+            for (unsigned i = pb; i < pe; ++i) {
+                vy[i] -= gravity * h * (invMass[i] > 0.0f ? 1.0f : 0.0f);
+                px[i] = x[i]; py[i] = y[i]; pz[i] = z[i];
+                x[i] += vx[i] * h; y[i] += vy[i] * h; z[i] += vz[i] * h;
+            }
+            barrier.wait();
+
+            for (int c = 0; c < colorCount(); ++c) {
+                if (c == serialBucket) {
+                    if (t == 0) solveRange(colorOffsets[size_t(c)], colorOffsets[size_t(c) + 1], alphaScale);
+                } else {
+                    unsigned cb0, ce0;
+                    slice(colorOffsets[size_t(c)], colorOffsets[size_t(c) + 1], cb0, ce0);
+                    solveRange(cb0, ce0, alphaScale);
+                }
+                barrier.wait();
+            }
+
+            // Çarpışma ve hız sadece kendi dilimi - sonraki tahmin için barrier gerekmez
+            collideRange(pb, pe);
+            const float invH = 1.0f / h;
+            for (unsigned i = pb; i < pe; ++i) {
+                vx[i] = (x[i] - px[i]) * invH * damping;
+                vy[i] = (y[i] - py[i]) * invH * damping;
+                vz[i] = (z[i] - pz[i]) * invH * damping;
+            }
+        }
+    });
+
+    stepStats.lastMs = timer.nsecsElapsed() / 1e6;
+    stepStats.averageMs = stepStats.averageMs == 0.0 ? stepStats.lastMs
+                                                     : stepStats.averageMs * 0.9 + stepStats.lastMs * 0.1;
+    stepStats.substeps = kSubsteps;
+    stepStats.threads = int(threads);
+}
+
+void ClothSimulation::computeNormals(unsigned begin, unsigned end)
+{
+    // Komşu üçgenlerin alan ağırlıklı normalleri (çapraz çarpım uzunluğu = 2 * alan)
+    for (unsigned p = begin; p < end; ++p) {
+        float sx = 0.0f, sy = 0.0f, sz = 0.0f;
+        for (unsigned k = adjacencyOffsets[p]; k < adjacencyOffsets[p + 1]; ++k) {
+            const unsigned *tri = &triangles[size_t(adjacency[k]) * 3];
+            const float e1x = x[tri[1]] - x[tri[0]], e1y = y[tri[1]] - y[tri[0]], e1z = z[tri[1]] - z[tri[0]];
+            const float e2x = x[tri[2]] - x[tri[0]], e2y = y[tri[2]] - y[tri[0]], e2z = z[tri[2]] - z[tri[0]];
+            sx += e1y * e2z - e1z * e2y;
+            sy += e1z * e2x - e1x * e2z;
+            sz += e1x * e2y - e1y * e2x;
+        }
+        const float len = std::sqrt(sx * sx + sy * sy + sz * sz);
+        const float inv = len > 0.0f ? normalSign / len : 0.0f;
+        nx[p] = sx * inv; ny[p] = sy * inv; nz[p] = sz * inv;
+    }
+}
+
+void ClothSimulation::writeVertices(std::vector<float> &verts)
+{
+    if (x.empty() || verts.size() != vertexParticle.size() * PackedScene::kFloatsPerVertex) return;
+
+    parallelFor(x.size(), 8192, [&](size_t begin, size_t end) {
+        computeNormals(unsigned(begin), unsigned(end));
+    });
+    parallelFor(vertexParticle.size(), 16384, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            const unsigned p = vertexParticle[v];
+            float *out = &verts[v * PackedScene::kFloatsPerVertex];
+            out[0] = x[p]; out[1] = y[p]; out[2] = z[p];
+            out[5] = nx[p]; out[6] = ny[p]; out[7] = nz[p];
+        }
+    });
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <QVector3D>
+#include <vector>
+
+// Giysi önizlemesi için konum tabanlı (XPBD) kumaş simülasyonu, sadece CPU.
+// Render vertex'leri konuma göre kaynaklanıp (UV dikişleri) parçacık olur;
+// her üçgen kenarı bir mesafe, iki üçgenin paylaştığı kenarın karşı köşeleri
+// bir bükülme kısıtıdır. Kısıtlar parçacık paylaşmayan renklere ayrılır, her
+// renk tüm çekirdeklerde kilitsiz çözülür. Gövde: kapsüllerden vekil.
+class ClothSimulation
+{
+public:
+    struct Capsule {
+        QVector3D a, b;   // model uzayında eksen uçları
+        float     radius = 0.0f;
+    };
+
+    struct StepStats {
+        double lastMs = 0.0;      // son step() süresi
+        double averageMs = 0.0;   // üstel ortalama
+        int    substeps = 0;
+        int    threads = 0;
+    };
+
+    // verts: PackedScene::kFloatsPerVertex düzeni, idx: üçgen listesi
+    bool build(const std::vector<float> &verts, const std::vector<unsigned> &idx);
+    void clear();
+    bool isEmpty() const { return x.empty(); }
+
+    // Sabit dt (saniye), substep başına bir çözüm geçişi
+    void step(float dt);
+    // Güncel konum ve normaller render vertex'lerine yazılır (UV korunur)
+    void writeVertices(std::vector<float> &verts);
+
+    // Giysi bounds'undan kaba gövde (gövde, omuz, kollar); yarıçaplar
+    // başlangıç pozundaki kumaşı içine almayacak şekilde küçültülür
+    void fitBodyProxy();
+    void setBodyProxy(const std::vector<Capsule> &body) { capsules = body; }
+    const std::vector<Capsule> &bodyProxy() const { return capsules; }
+
+    int particleCount()   const { return int(x.size()); }
+    int constraintCount() const { return int(restLength.size()); }
+    int colorCount()      const { return colorOffsets.empty() ? 0 : int(colorOffsets.size()) - 1; }
+    const StepStats &stats() const { return stepStats; }
+
+private:
+    void solveRange(unsigned begin, unsigned end, float alphaScale);
+    void collideRange(unsigned begin, unsigned end);
+    void buildTethers();
+    void computeNormals(unsigned begin, unsigned end);
+
+    static constexpr int   kSubsteps = 8;
+    static constexpr int   kSerialColor = 63;   // renge sığmayanlar tek thread'de
+    static constexpr float kPinBand = 0.03f;    // yakanın bu kadarı sabit (yükseklik oranı)
+
+    // Parçacıklar (SoA): tahmin/hız döngüleri vektörleşir
+    std::vector<float> x, y, z;
+    std::vector<float> px, py, pz;   // substep başındaki konum
+    std::vector<float> vx, vy, vz;
+    std::vector<float> invMass;      // 0: sabit
+
+    // Uzun menzilli bağ: en yakın sabit parçacıktan başlangıç mesafesinden uzağa
+    // gidemez. Tek geçişli çözücüde uzun giysinin "sünmesini" engeller.
+    std::vector<unsigned> tetherAnchor;
+    std::vector<float>    tetherLength;
+
+    // Kısıtlar (SoA), renge göre ardışık: colorOffsets[c] .. colorOffsets[c + 1]
+    std::vector<unsigned> ca, cb;
+    std::vector<float>    restLength;
+    std::vector<float>    compliance;
+    std::vector<unsigned> colorOffsets;
+    int serialBucket = -1;   // kSerialColor'a düşenlerin renk indeksi
+
+    // Render eşlemesi ve normal hesabı (parçacık -> komşu üçgenler, CSR)
+    std::vector<unsigned> vertexParticle;
+    std::vector<unsigned> triangles;
+    std::vector<unsigned> adjacencyOffsets, adjacency;
+    std::vector<float>    nx, ny, nz;
+    float normalSign = 1.0f;   // sarım yönü kaynak normallerle ters ise -1
+
+    std::vector<Capsule> capsules;
+    QVector3D boundsMin, boundsMax;
+    float gravity = 9.81f;
+    float thickness = 0.0f;
+
+    StepStats stepStats;
+};
@@ -3,12 +3,21 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QDir>
+#include <QStatusBar>
+#include <QSet>
+#include <QDateTime>
 
 DesktopViewer::DesktopViewer(QWidget *parent)
     : QMainWindow(parent),
       viewport(new GLViewport(this)),
-      modelList(new QListWidget(this)),
-      btnRefresh(new QPushButton("Yenile", this))
+      modelList(new QListView(this)),
+      filterEdit(new QLineEdit(this)),
+      sortBox(new QComboBox(this)),
+      btnRefresh(new QPushButton("Yenile", this)),
+      btnMultiView(new QPushButton("Ön / Yan / Arka", this)),
+      btnCloth(new QPushButton("Kumaş Simülasyonu", this)),
+      catalogModel(new CatalogModel(bundle, this)),
+      catalogFilter(new CatalogFilter(this))
 {
     initializeUI();
 }
@@ -33,9 +42,28 @@ void DesktopViewer::initializeUI()
     labLeft->setAlignment(Qt::AlignCenter);
     labLeft->setMaximumHeight(25);
     
+    catalogFilter->setSourceModel(catalogModel);
+    catalogFilter->sort(0);
+    modelList->setModel(catalogFilter);
+    modelList->setIconSize(QSize(48, 48));
+    modelList->setUniformItemSizes(true);
+    modelList->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    filterEdit->setPlaceholderText("Filtre: triangles > 500k, tex >= 2048, shirt");
+    filterEdit->setClearButtonEnabled(true);
+    sortBox->addItem("Ada göre", ModelQuery::ByName);
+    sortBox->addItem("Boyuta göre", ModelQuery::BySize);
+    sortBox->addItem("Üçgen sayısına göre", ModelQuery::ByTriangles);
+    sortBox->addItem("Texture boyutuna göre", ModelQuery::ByTextureSize);
+    sortBox->addItem("Materyal sayısına göre", ModelQuery::ByMaterials);
+
     left->addWidget(labLeft);
+    left->addWidget(filterEdit);
+    left->addWidget(sortBox);
     left->addWidget(modelList);
     left->addWidget(btnRefresh);
+    left->addWidget(btnMultiView);
+    left->addWidget(btnCloth);
     left->setContentsMargins(0, 0, 0, 0);
 
     // Right panel
@@ -50,8 +78,29 @@ void DesktopViewer::initializeUI()
     setCentralWidget(central);
     setWindowTitle("Desktop Garment Viewer");
 
-    connect(modelList,&QListWidget::itemClicked,this,&DesktopViewer::onModelSelected);
+    connect(modelList,&QListView::clicked,this,&DesktopViewer::onModelSelected);
     connect(btnRefresh,&QPushButton::clicked,this,&DesktopViewer::onRefreshClicked);
+
+    // Çoklu görünüm: buton ve viewport'taki V tuşu birbirini senkron tutar
+    btnMultiView->setCheckable(true);
+    connect(btnMultiView,&QPushButton::toggled,viewport,&GLViewport::setMultiView);
+    connect(viewport,&GLViewport::multiViewChanged,btnMultiView,&QPushButton::setChecked);
+    connect(viewport,&GLViewport::surfacePicked,this,&DesktopViewer::onSurfacePicked);
+
+    // Kumaş: buton ve viewport'taki C tuşu senkron (desteklenmeyen sahnede kapanır)
+    btnCloth->setCheckable(true);
+    connect(btnCloth,&QPushButton::toggled,viewport,&GLViewport::setClothSimulation);
+    connect(viewport,&GLViewport::clothSimulationChanged,btnCloth,&QPushButton::setChecked);
+
+    // Yazarken her tuşta değil, kısa bir duraksamadan sonra filtrele
+    filterTimer.setSingleShot(true);
+    filterTimer.setInterval(150);
+    connect(filterEdit,&QLineEdit::textChanged,&filterTimer,qOverload<>(&QTimer::start));
+    connect(&filterTimer,&QTimer::timeout,this,&DesktopViewer::applyFilter);
+    connect(sortBox,&QComboBox::currentIndexChanged,this,[this]() {
+        catalogFilter->setSortKey(ModelQuery::SortKey(sortBox->currentData().toInt()));
+    });
+    connect(&index,&ModelIndex::updated,this,&DesktopViewer::onIndexUpdated);
 }
 
 void DesktopViewer::clearScene()
@@ -59,26 +108,81 @@ void DesktopViewer::clearScene()
     viewport->update();
 }
 
-void DesktopViewer::onModelSelected(QListWidgetItem *item)
+void DesktopViewer::onModelSelected(const QModelIndex &item)
 {
-    const QString name = item->text();
+    const QString name = item.data(Qt::DisplayRole).toString();
     printf("Model seçildi: %s\n", name.toStdString().c_str());
     fflush(stdout);
     
     setWindowTitle("Seçilen Model: " + name);
-    
+
+    // Bundle kaydı: import yok, hazır diziler mmap'ten
+    const QVariant bundleIndex = item.data(CatalogModel::BundleIndexRole);
+    if(bundleIndex.isValid()) {
+        PackedScene packed;
+        const bool loaded = bundle.load(bundleIndex.toInt(), packed) &&
+                            viewport->loadPackedModel(name, std::move(packed));
+        printf("Model yükleme sonucu (bundle): %s\n", loaded ? "BAŞARILI" : "BAŞARISIZ");
+        fflush(stdout);
+        return;
+    }
+
     bool result = viewport->loadModel(name);
     printf("Model yükleme sonucu: %s\n", result ? "BAŞARILI" : "BAŞARISIZ");
     fflush(stdout);
 }
 
+void DesktopViewer::onSurfacePicked(const PickResult &result)
+{
+    if(!result.hit) {
+        statusBar()->showMessage("Seçim: boşluk");
+        return;
+    }
+
+    statusBar()->showMessage(QString("Mesh %1 (%2) | Materyal: %3 | Nokta: (%4, %5, %6) | %7 us")
+        .arg(result.meshIndex)
+        .arg(result.meshName.isEmpty() ? "-" : result.meshName)
+        .arg(result.materialName.isEmpty() ? "-" : result.materialName)
+        .arg(result.position.x(), 0, 'f', 4)
+        .arg(result.position.y(), 0, 'f', 4)
+        .arg(result.position.z(), 0, 'f', 4)
+        .arg(result.elapsedNs / 1000.0, 0, 'f', 1));
+}
+
 void DesktopViewer::onRefreshClicked()
 {
     printf("=== Yenile butonuna basıldı ===\n");
     fflush(stdout);
     
-    modelList->clear();
-    
+    std::vector<CatalogModel::Item> catalog;
+
+    // Önce katalog bundle'ı: isim ve özet bilgi TOC'tan (indeks gerekmez)
+    QSet<QString> bundled;
+    const QString bundlePath = findBundle();
+    if(!bundlePath.isEmpty() && bundle.open(bundlePath)) {
+        for(int i = 0; i < bundle.count(); ++i) {
+            const CatalogBundle::Entry &e = bundle.entry(i);
+            CatalogModel::Item item;
+            item.bundleIndex = i;
+            item.info.path = bundle.name(i);
+            item.name = item.info.path;
+            item.info.size = qint64(e.sourceBytes);
+            item.info.mtime = e.sourceMtime;
+            item.info.indexed = true;
+            item.info.triangles = e.triangleCount;
+            item.info.vertices = e.vertexCount;
+            item.info.meshes = e.meshCount;
+            item.info.materials = e.materialCount;
+            item.info.textures = e.textureWidth > 0 ? 1 : 0;
+            item.info.textureWidth = e.textureWidth;
+            item.info.textureHeight = e.textureHeight;
+            item.key = ModelQuery::nameKey(item.name);
+            catalog.push_back(item);
+            bundled.insert(item.info.path);
+        }
+        printf("Bundle'dan %d model listelendi\n", bundle.count());
+    }
+
     QDir dir(".");
     QStringList filters;
     filters << "*.obj" << "*.glb" << "*.fbx";
@@ -89,17 +193,68 @@ void DesktopViewer::onRefreshClicked()
     printf("Bulunan dosya sayısı: %lld\n", (long long)files.size());
     fflush(stdout);
     
+    QFileInfoList loose;
     for(const QFileInfo &file : files) {
-        printf("Dosya ekleniyor: %s (%.2f KB)\n", 
-               file.fileName().toStdString().c_str(),
-               file.size() / 1024.0);
-        modelList->addItem(file.fileName());
-        fflush(stdout);
+        if(bundled.contains(file.fileName())) continue;   // bundle'daki kopyası kullanılır
+        CatalogModel::Item item;
+        item.name = file.fileName();
+        if(const ModelInfo *known = index.find(file)) {
+            item.info = *known;
+        } else {
+            item.info.path = file.absoluteFilePath();
+            item.info.size = file.size();
+            item.info.mtime = file.lastModified().toMSecsSinceEpoch();
+        }
+        item.key = ModelQuery::nameKey(item.name);
+        catalog.push_back(item);
+        loose.append(file);
     }
-    
-    if(modelList->count() == 0) {
-        modelList->addItem("Hiç model dosyası bulunamadı");
+
+    if(catalog.empty()) {
         printf("Hiç model dosyası bulunamadı!\n");
         fflush(stdout);
     }
+
+    // Yeni/değişen dosyalar arka planda indekslenir; liste hemen gösterilir
+    catalogModel->setItems(std::move(catalog));
+    index.refresh(loose);
+    applyFilter();
+}
+
+void DesktopViewer::onIndexUpdated()
+{
+    catalogModel->updateInfo(index);
+    showCount();
+}
+
+void DesktopViewer::applyFilter()
+{
+    std::vector<ModelQuery::Condition> conditions;
+    QString error;
+    if(!ModelQuery::parse(filterEdit->text(), conditions, &error)) {
+        statusBar()->showMessage(error);
+        return;
+    }
+
+    catalogFilter->setConditions(std::move(conditions));
+    showCount();
+}
+
+void DesktopViewer::showCount()
+{
+    if(catalogModel->rowCount() == 0) {
+        statusBar()->showMessage("Hiç model dosyası bulunamadı");
+        return;
+    }
+    statusBar()->showMessage(QString("%1 / %2 model").arg(catalogFilter->rowCount()).arg(catalogModel->rowCount()));
+}
+
+QString DesktopViewer::findBundle() const
+{
+    // DESKTOPVIEWER_BUNDLE ile açıkça, yoksa çalışma dizinindeki ilk .dvb
+    const QString configured = qEnvironmentVariable("DESKTOPVIEWER_BUNDLE");
+    if(!configured.isEmpty()) return configured;
+
+    const QFileInfoList bundles = QDir(".").entryInfoList({"*.dvb"}, QDir::Files, QDir::Name);
+    return bundles.isEmpty() ? QString() : bundles.first().absoluteFilePath();
 }
@@ -4,11 +4,17 @@
 #include <QFileInfo>
 #include <QCoreApplication>
 #include <QMainWindow>
-#include <QListWidget>
+#include <QListView>
 #include <QPushButton>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QTimer>
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 #include "glviewport.h"
+#include "catalogbundle.h"
+#include "modelindex.h"
+#include "catalogmodel.h"
 
 class DesktopViewer : public QMainWindow
 {
@@ -18,8 +24,10 @@ public:
     ~DesktopViewer();
 
 public slots:
-    void onModelSelected(QListWidgetItem *item);
+    void onModelSelected(const QModelIndex &item);
     void onRefreshClicked();
+    void onSurfacePicked(const PickResult &result);
+    void applyFilter();
 
 signals:
     void modelLoaded(const QString &modelName);
@@ -28,10 +36,26 @@ signals:
 private:
     void initializeUI();
     void clearScene();
+    QString findBundle() const;
+    void onIndexUpdated();
+    void showCount();
 
     GLViewport   *viewport;
-    QListWidget  *modelList;
+    QListView    *modelList;
+    QLineEdit    *filterEdit;
+    QComboBox    *sortBox;
     QPushButton  *btnRefresh;
+    QPushButton  *btnMultiView;
+    QPushButton  *btnCloth;
+    QTimer        filterTimer;
+
+    // Kiosk dağıtımı: tek dosyalık katalog (varsa liste ve yüklemeler buradan)
+    CatalogBundle bundle;
+
+    // Katalog: öğeler yenilemede bir kez kurulur, filtre/sıralama proxy'de
+    ModelIndex     index;
+    CatalogModel  *catalogModel;
+    CatalogFilter *catalogFilter;
 
     // (unused yet)
     QString currentDirectory;
@@ -1,9 +1,37 @@
 #include "glviewport.h"
+#include "shaders.h"
+#include "aobake.h"
+#include "mmapiosystem.h"
+#include "objloader.h"
 #include <QMouseEvent>
 #include <QWheelEvent>
+#include <QElapsedTimer>
 #include <vector>
+#include <algorithm>
 
-GLViewport::GLViewport(QWidget *parent):QOpenGLWidget(parent){}
+GLViewport::GLViewport(QWidget *parent):QOpenGLWidget(parent)
+{
+    // Kaydetme sırasında birden çok değişiklik sinyali gelir - son sinyalden sonra yükle
+    reloadTimer.setSingleShot(true);
+    reloadTimer.setInterval(kReloadDebounceMs);
+    connect(&reloadTimer, &QTimer::timeout, this, &GLViewport::startReload);
+    connect(&fileWatcher, &QFileSystemWatcher::fileChanged, this, [this](const QString &path) {
+        printf("Değişiklik algılandı: %s\n", path.toStdString().c_str());
+        fflush(stdout);
+        reloadTimer.start();
+    });
+
+    clothTimer.setInterval(kClothIntervalMs);
+    connect(&clothTimer, &QTimer::timeout, this, &GLViewport::stepCloth);
+}
+
+GLViewport::~GLViewport()
+{
+    if(reloadThread) {
+        reloadThread->wait();
+        delete reloadThread;
+    }
+}
 
 /* ---------- OpenGL boilerplate ------------------------------------------------ */
 void GLViewport::initializeGL()
@@ -11,76 +39,85 @@ void GLViewport::initializeGL()
     initializeOpenGLFunctions();
     glEnable(GL_DEPTH_TEST);
 
-    // Texture'lı vertex shader
-    shader.addShaderFromSourceCode(QOpenGLShader::Vertex,
-        "#version 330 core\n"
-        "layout(location=0) in vec3 pos;"
-        "layout(location=1) in vec2 texCoord;"
-        "layout(location=2) in vec3 normal;"
-        "uniform mat4 mvp;"
-        "out vec2 TexCoord;"
-        "out vec3 Normal;"
-        "void main(){"
-        "    gl_Position = mvp * vec4(pos, 1.0);"
-        "    TexCoord = texCoord;"
-        "    Normal = normal;"
-        "}");
-
-    // Texture'lı fragment shader
-   
-bool fragmentOK = shader.addShaderFromSourceCode(QOpenGLShader::Fragment,
-    "#version 330 core\n"
-    "in vec2 TexCoord;"
-    "out vec4 frag;"
-    "uniform sampler2D ourTexture;"
-    "uniform bool hasTexture;"
-    "void main(){"
-    "    if(hasTexture) {"
-    "        frag = texture(ourTexture, TexCoord);" // Sadece texture
-    "    } else {"
-    "        frag = vec4(0.7, 0.7, 0.7, 1.0);"     // Gri renk
-    "    }"
-    "}");
+    shader.addShaderFromSourceCode(QOpenGLShader::Vertex, Shaders::vertex);
+    shader.addShaderFromSourceCode(QOpenGLShader::Fragment, Shaders::fragment);
 
     shader.link();    
     glGenVertexArrays(1, &vao);
     glGenBuffers(1, &vbo);
     glGenBuffers(1, &ebo);
+    glGenBuffers(1, &aoVbo);
+    glGenBuffers(1, &instanceVbo);
+    glGenBuffers(1, &instanceNormalVbo);
     glGenTextures(1, &textureID);  // Texture ID ekle
+
+    // AO attribute'u olmayan modeller için varsayılan: örtülme yok
+    glVertexAttrib1f(3, 1.0f);
+    clearInstances();
+
+    meshletRenderer.initialize(this);
 }
 
-void GLViewport::resizeGL(int w,int h)
+QRect GLViewport::viewRect(int index) const
 {
-    projection.setToIdentity();
-    projection.perspective(45.f,float(w)/qMax(1,h),0.1f,100.f);
+    // Görünümler yan yana eşit sütunlar (widget koordinatları)
+    const int w = width() / viewCount;
+    const int x = index * w;
+    return QRect(x, 0, index == viewCount - 1 ? width() - x : w, height());
 }
 
-void GLViewport::updateView()
+int GLViewport::viewAt(const QPointF &pos) const
 {
-    const float ry = qDegreesToRadians(yaw);
-    const float rp = qDegreesToRadians(pitch);
-    
-    // Kamera pozisyonu
-    QVector3D eye(distance * qCos(rp) * qSin(ry),
-                  distance * qSin(rp),
-                  distance * qCos(rp) * qCos(ry));
-    
-    // Sahne merkezine bak (0,0,0) - model merkezi değil
-    QVector3D target(0, 0, 0); 
-    QVector3D up(0, 1, 0);
-    
-    view.setToIdentity();
-    view.lookAt(eye, target, up);
+    for(int i = 0; i < viewCount; ++i)
+        if(viewRect(i).contains(pos.toPoint())) return i;
+    return 0;
+}
+
+void GLViewport::updateView(int index)
+{
+    const ViewCamera &cam = cameras[index];
+    const QRect rect = viewRect(index);
+    projection.setToIdentity();
+    projection.perspective(45.f, float(rect.width())/qMax(1, rect.height()), 0.1f, 100.f);
+    view = SceneData::orbitView(cam.yaw, cam.pitch, cam.distance);
 }
 
 void GLViewport::paintGL()
 {
-    glClearColor(0.2f, 0.3f, 0.4f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    
+    const qreal dpr = devicePixelRatioF();
+    if(useMeshlets) meshletRenderer.beginFrame();   // görünümler aynı kareyi paylaşır
+
+    if(viewCount > 1) {
+        // Ayraç rengi, görünümler scissor ile kendi arka planlarını temizler
+        glClearColor(0.1f, 0.1f, 0.12f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glEnable(GL_SCISSOR_TEST);
+    }
+
+    for(int i = 0; i < viewCount; ++i) {
+        const QRect r = viewRect(i).adjusted(0, 0, i < viewCount - 1 ? -1 : 0, 0);
+        // GL viewport sol alt köşeden, fiziksel piksel cinsinden
+        const GLint x = GLint(r.x() * dpr);
+        const GLint y = GLint((height() - r.y() - r.height()) * dpr);
+        const GLsizei w = GLsizei(r.width() * dpr);
+        const GLsizei h = GLsizei(r.height() * dpr);
+        glViewport(x, y, w, h);
+        glScissor(x, y, w, h);
+
+        glClearColor(0.2f, 0.3f, 0.4f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        drawView(i);
+    }
+
+    glDisable(GL_SCISSOR_TEST);
+    glViewport(0, 0, GLsizei(width() * dpr), GLsizei(height() * dpr));
+}
+
+void GLViewport::drawView(int index)
+{
     if(indexCount == 0) return;
 
-    updateView();
+    updateView(index);
     shader.bind();
     shader.setUniformValue("mvp", projection * view * model);
     
@@ -100,9 +137,52 @@ void GLViewport::paintGL()
         printf("Texture YOK - solid renk kullanılacak\n");
     }
     
-    glBindVertexArray(vao);
-    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
-    glBindVertexArray(0);
+    if(useMeshlets) {
+        // Büyük tarama: görünmeyen kümeleri CPU'da ele, kalanları tek çağrıda çiz. Arka yüz
+        // (koni + GL_CULL_FACE) eleme sadece B ile: yaka/etekten görünen iç yüz kaybolmasın.
+        // Her görünüm kendi kamerasıyla ayrı elenir; slot havuzu ve kare sayacı ortak.
+        const QMatrix4x4 modelView = view * model;
+        const QVector3D cameraPos = modelView.inverted().map(QVector3D(0, 0, 0));
+        if(coneCulling) glEnable(GL_CULL_FACE);
+        const MeshletRenderer::FrameStats stats =
+            meshletRenderer.draw(projection * modelView, cameraPos, coneCulling);
+        glDisable(GL_CULL_FACE);
+
+        if(stats.uploaded > 0) {
+            printf("Meshlet [%s]: görünür %d/%d, çizilen %d, yüklenen %d, bekleyen %d\n",
+                   cameras[index].name, stats.visible, meshletRenderer.meshletCount(),
+                   stats.drawn, stats.uploaded, stats.pending);
+        }
+        // Sadece kare başı yükleme sınırı bekletiyorsa devam et; bütçe doluysa
+        // yeniden çizmek bir şey değiştirmez (sonsuz repaint olurdu)
+        if(stats.pending > 0) update();
+    } else if(!instanceBatches.empty()) {
+        // Tekrar eden mesh başına bir instanced çağrı (tek kullanılanlar ilk batch'te birleşik)
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+        for(const PackedScene::Instanced::Batch &batch : instanceBatches) {
+            // GL 3.3'te baseInstance yok - matris attribute'larını batch'in ilk instance'ına kaydır
+            const size_t offset = size_t(batch.firstInstance) * 16 * sizeof(float);
+            for(int c = 0; c < 4; ++c)
+                glVertexAttribPointer(4 + c, 4, GL_FLOAT, GL_FALSE, 16 * sizeof(float),
+                                      (void*)(offset + c * 4 * sizeof(float)));
+            glBindBuffer(GL_ARRAY_BUFFER, instanceNormalVbo);
+            const size_t normalOffset = size_t(batch.firstInstance) * 9 * sizeof(float);
+            for(int c = 0; c < 3; ++c)
+                glVertexAttribPointer(8 + c, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float),
+                                      (void*)(normalOffset + c * 3 * sizeof(float)));
+            glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+            glDrawElementsInstanced(GL_TRIANGLES, GLsizei(batch.indexCount), GL_UNSIGNED_INT,
+                                    (void*)(size_t(batch.firstIndex) * sizeof(unsigned)),
+                                    GLsizei(batch.instanceCount));
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+    } else {
+        glBindVertexArray(vao);
+        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+        glBindVertexArray(0);
+    }
     
     // CLEANUP
     if(hasLoadedTexture) {
@@ -122,109 +202,90 @@ void GLViewport::uploadAllMeshes(const aiScene *scene)
     // Önce bounding box hesapla (tüm mesh'ler için)
     calculateBoundingBoxForScene(scene);
 
-    // Tüm mesh'lerin vertex ve index verilerini birleştir
-    std::vector<float> verts;
-    std::vector<unsigned> idx;
-    unsigned vertexOffset = 0;
-
     printf("=== TÜM MESH'LER YÜKLENİYOR ===\n");
     printf("Toplam mesh sayısı: %d\n", scene->mNumMeshes);
 
     for (unsigned int mIdx = 0; mIdx < scene->mNumMeshes; ++mIdx) {
         const aiMesh *m = scene->mMeshes[mIdx];
-        
         if (!m || m->mNumVertices == 0) {
             printf("Mesh %d boş, atlanıyor\n", mIdx);
             continue;
         }
+        printf("Mesh %d: vertices=%d, faces=%d, uv=%s, normal=%s\n", mIdx,
+               m->mNumVertices, m->mNumFaces,
+               m->mTextureCoords[0] ? "VAR" : "YOK", m->mNormals ? "VAR" : "YOK");
+    }
 
-        printf("Mesh %d: vertices=%d, faces=%d\n", mIdx, m->mNumVertices, m->mNumFaces);
-        printf("  Texture coords: %s\n", m->mTextureCoords[0] ? "VAR" : "YOK");
-        printf("  Normals: %s\n", m->mNormals ? "VAR" : "YOK");
-
-        // UV koordinatlarını kontrol et (debug için)
-        if (m->mTextureCoords[0]) {
-            float minU = 1000, maxU = -1000, minV = 1000, maxV = -1000;
-            for (unsigned i = 0; i < qMin(10u, m->mNumVertices); ++i) {
-                float u = m->mTextureCoords[0][i].x;
-                float v = m->mTextureCoords[0][i].y;
-                minU = qMin(minU, u); maxU = qMax(maxU, u);
-                minV = qMin(minV, v); maxV = qMax(maxV, v);
-            }
-            printf("  UV range: U(%.3f-%.3f), V(%.3f-%.3f)\n", minU, maxU, minV, maxV);
-        }
-
-        // Vertex data: position + texCoord + normal
-        for (unsigned i = 0; i < m->mNumVertices; ++i) {
-            // Position - Model merkezine göre normalize et
-            verts.push_back(m->mVertices[i].x);
-            verts.push_back(m->mVertices[i].y);
-            verts.push_back(m->mVertices[i].z);
-
-            // Texture coordinates - DÜZELTME
-            if (m->mTextureCoords[0]) {
-                float u = m->mTextureCoords[0][i].x;
-                float v = m->mTextureCoords[0][i].y;
-                
-                // UV koordinatlarını normalize et (0-1 aralığına sığdır)
-                u = qBound(0.0f, u, 1.0f);
-                v = qBound(0.0f, v, 1.0f);
-                
-                // V koordinatını çevir (çoğu zaman bu gerekli oluyor)
-                v = 1.0f - v;
-                
-                verts.push_back(u);
-                verts.push_back(v);
-            } else {
-                // Default UV koordinatları
-                verts.push_back(0.5f);  // Merkez
-                verts.push_back(0.5f);
-            }
-
-            // Normals
-            if (m->mNormals) {
-                verts.push_back(m->mNormals[i].x);
-                verts.push_back(m->mNormals[i].y);
-                verts.push_back(m->mNormals[i].z);
-            } else {
-                // Default normal (yukarı doğru)
-                verts.push_back(0.0f);
-                verts.push_back(1.0f);
-                verts.push_back(0.0f);
-            }
-        }
-
-        // Index data - KONTROL EKLENDİ
-        for (unsigned i = 0; i < m->mNumFaces; ++i) {
-            const aiFace &face = m->mFaces[i];
-            
-            // Sadece üçgen face'leri kabul et
-            if (face.mNumIndices != 3) {
-                printf("Uyarı: Mesh %d, Face %d üçgen değil (%d vertex)\n", 
-                       mIdx, i, face.mNumIndices);
-                continue;
-            }
-            
-            // Index'leri offset ile ekle
-            idx.push_back(face.mIndices[0] + vertexOffset);
-            idx.push_back(face.mIndices[1] + vertexOffset);
-            idx.push_back(face.mIndices[2] + vertexOffset);
-        }
+    // Tüm mesh'lerin vertex ve index verilerini birleştir
+    PackedScene packed;
+    SceneData::packMeshes(scene, packed);
+    SceneData::buildInstancing(scene, packed);
+    packed.boundingMin = boundingMin;
+    packed.boundingMax = boundingMax;
+    packed.radius = modelRadius;
+
+    uploadScene(std::move(packed));
+}
 
-        vertexOffset += m->mNumVertices;
-        printf("Mesh %d tamamlandı, toplam vertex: %d\n", mIdx, vertexOffset);
+void GLViewport::uploadScene(PackedScene &&packed)
+{
+    // Picking BVH'ı (paralel kurulur, model ile cache'lenir) - AO da aynı BVH'ı kullanır
+    Picking::loadOrBuildBVH(bvh, packed, currentModelPath);
+    meshRanges = packed.meshes;
+
+    // Import-time AO (cache'de yoksa tüm çekirdeklerde hesaplanır)
+    AmbientOcclusion::loadOrBake(packed, currentModelPath, &bvh);
+    SceneData::resolveInstanceAo(packed);
+
+    if (shouldUseMeshlets(packed.triangleCount())) {
+        // Tek büyük index buffer yerine meshlet'ler - sadece görünür kümeler çizilir/yüklenir
+        MeshletData meshlets = Meshlets::build(packed, bvh);
+        indexCount = static_cast<int>(packed.idx.size());
+        meshletRenderer.setScene(std::move(packed), std::move(meshlets),
+                                 MeshletRenderer::budgetFromEnvironment());
+        useMeshlets = true;
+
+        // Monolitik buffer'ları boşalt
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        vboSignature = eboSignature = aoSignature = HotReload::BufferSignature();
+        clearInstances();
+        resetCloth();
+        return;
     }
 
-    if (verts.empty() || idx.empty()) {
+    meshletRenderer.clear();
+    useMeshlets = false;
+    uploadPackedScene(packed);
+    resetCloth();
+}
+
+void GLViewport::uploadPackedScene(const PackedScene &packed)
+{
+    if (packed.isEmpty()) {
         printf("Hata: Vertex veya index verisi yok!\n");
         return;
     }
 
+    // Tekrar eden mesh'ler varsa GPU'ya kopyasız (instanced) düzen gider
+    const bool instanced = !packed.instanced.isEmpty();
+    const std::vector<float>    &verts = instanced ? packed.instanced.verts : packed.verts;
+    const std::vector<unsigned> &idx   = instanced ? packed.instanced.idx   : packed.idx;
+    const std::vector<float>    &ao    = instanced ? packed.instanced.ao    : packed.ao;
+    const size_t vertexCount = verts.size() / PackedScene::kFloatsPerVertex;
+
     indexCount = static_cast<int>(idx.size());
     printf("=== UPLOAD SONUCU ===\n");
-    printf("Toplam vertex sayısı: %d\n", static_cast<int>(verts.size() / 8));
+    printf("Toplam vertex sayısı: %d\n", int(vertexCount));
     printf("Toplam index sayısı: %d\n", indexCount);
-    printf("Toplam üçgen sayısı: %d\n", indexCount / 3);
+    printf("Toplam üçgen sayısı: %d\n", packed.triangleCount());
+    if (instanced) {
+        printf("Instanced VBO: %.2f MB (düzleştirilmiş %.2f MB), %d çizim çağrısı\n",
+               verts.size() * sizeof(float) / (1024.0 * 1024.0),
+               packed.verts.size() * sizeof(float) / (1024.0 * 1024.0),
+               int(packed.instanced.batches.size()));
+    }
 
     // OpenGL Buffer'larına yükle
     glBindVertexArray(vao);
@@ -232,6 +293,7 @@ void GLViewport::uploadAllMeshes(const aiScene *scene)
     // Vertex buffer
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(float), verts.data(), GL_STATIC_DRAW);
+    vboSignature = HotReload::signature(verts.data(), verts.size() * sizeof(float));
 
     // Vertex attribute'ları tanımla
     // Position attribute (location = 0): 3 float
@@ -249,19 +311,82 @@ void GLViewport::uploadAllMeshes(const aiScene *scene)
     // Element buffer (index buffer)
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx.size() * sizeof(unsigned), idx.data(), GL_STATIC_DRAW);
+    eboSignature = HotReload::signature(idx.data(), idx.size() * sizeof(unsigned));
+
+    // AO attribute (location = 3): ayrı buffer, 1 float
+    if (ao.size() == vertexCount) {
+        glBindBuffer(GL_ARRAY_BUFFER, aoVbo);
+        glBufferData(GL_ARRAY_BUFFER, ao.size() * sizeof(float), ao.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
+        glEnableVertexAttribArray(3);
+        aoSignature = HotReload::signature(ao.data(), ao.size() * sizeof(float));
+    } else {
+        glDisableVertexAttribArray(3);
+        aoSignature = HotReload::BufferSignature();
+    }
 
     // Unbind
     glBindVertexArray(0);
 
+    if (instanced) uploadInstances(packed.instanced);
+    else clearInstances();
+
     printf("OpenGL buffer'ları başarıyla güncellendi\n");
     printf("========================\n");
 }
+
+void GLViewport::uploadInstances(const PackedScene::Instanced &instanced)
+{
+    instanceBatches = instanced.batches;
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, instanced.transforms.size() * sizeof(float),
+                 instanced.transforms.data(), GL_STATIC_DRAW);
+
+    // Normal matrisi: üst 3x3'ün ters-devriği (glTF düğümlerinde eşit olmayan ölçek sık)
+    const size_t instanceCount = instanced.transforms.size() / 16;
+    std::vector<float> normals(instanceCount * 9);
+    for (size_t i = 0; i < instanceCount; ++i) {
+        // transforms sütun öncelikli, QMatrix4x4(float*) satır öncelikli okur
+        const QMatrix3x3 n = QMatrix4x4(instanced.transforms.data() + i * 16).transposed().normalMatrix();
+        std::copy(n.constData(), n.constData() + 9, normals.begin() + i * 9);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, instanceNormalVbo);
+    glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(float), normals.data(), GL_STATIC_DRAW);
+
+    // mat4 = ardışık 4 vec4, mat3 = ardışık 3 vec3 attribute; instance başına bir
+    // kez ilerler. Pointer offset'leri batch'e göre drawView'da ayarlanır.
+    for (int c = 0; c < 7; ++c) {
+        glEnableVertexAttribArray(4 + c);
+        glVertexAttribDivisor(4 + c, 1);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GLViewport::clearInstances()
+{
+    instanceBatches.clear();
+
+    glBindVertexArray(vao);
+    for (int c = 0; c < 7; ++c)
+        glDisableVertexAttribArray(4 + c);
+    glBindVertexArray(0);
+
+    // Dizi kapalıyken shader instance ve normal matrisini bu sabit değerlerden okur: birim
+    for (int c = 0; c < 4; ++c)
+        glVertexAttrib4f(4 + c, c == 0, c == 1, c == 2, c == 3);
+    for (int c = 0; c < 3; ++c)
+        glVertexAttrib3f(8 + c, c == 0, c == 1, c == 2);
+}
 /* ---------- Assimp loader ----------------------------------------------------- */
 bool GLViewport::loadModel(const QString &filePath)
 {
     makeCurrent();
     
     printf("Model yükleniyor: %s\n", filePath.toStdString().c_str());
+    currentModelPath = filePath;
     
     // Eski texture'ları temizle
     if (hasLoadedTexture && textureID > 0) {
@@ -269,14 +394,25 @@ bool GLViewport::loadModel(const QString &filePath)
         textureID = 0;
         hasLoadedTexture = false;
     }
+    textureHash = 0;
+    textureSize = QSize();
     
-    const aiScene *scene = importer.ReadFile(
-        filePath.toStdString(),
-        aiProcess_Triangulate |
-        aiProcess_GenSmoothNormals |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_PreTransformVertices |
-        aiProcess_FlipUVs); // UV'leri çevir - ÖNEMLİ!
+    // Büyük OBJ taramaları: Assimp yerine çok çekirdekli hızlı yol
+    if (ObjLoader::isEnabledFor(filePath)) {
+        PackedScene packed;
+        QStringList dependencies;
+        if (ObjLoader::load(filePath, packed, &dependencies)) {
+            showPackedScene(std::move(packed), QStringList{filePath} + dependencies);
+            doneCurrent();
+            update();
+            return true;
+        }
+        printf("OBJ hızlı yol başarısız, Assimp ile deneniyor\n");
+    }
+
+    // Model ve dış dosyaları (.mtl, .bin, texture) mmap üzerinden okunur
+    MappedIOSystem::install(importer, filePath);
+    const aiScene *scene = importer.ReadFile(filePath.toStdString(), SceneData::importFlags());
 
     if(!scene || !scene->HasMeshes()) {
         printf("Model yükleme hatası: %s\n", importer.GetErrorString());
@@ -351,12 +487,46 @@ bool GLViewport::loadModel(const QString &filePath)
     
     // Kamerayı otomatik ayarla
     resetCamera();
+
+    // Dışarıda yeniden export edilirse otomatik yenile
+    watchModelFiles(QStringList{filePath} + SceneData::externalTexturePaths(scene, filePath));
     
     doneCurrent();
     update(); // Sahneyi yeniden çiz
     return true;
 }
 
+bool GLViewport::loadPackedModel(const QString &name, PackedScene &&packed)
+{
+    if (packed.isEmpty()) return false;
+    makeCurrent();
+
+    printf("Model (bundle) yükleniyor: %s\n", name.toStdString().c_str());
+    // Diskte kaynak dosya yok: hot reload ve BVH/AO cache'i devre dışı
+    currentModelPath.clear();
+    textureHash = 0;
+    textureSize = QSize();
+
+    showPackedScene(std::move(packed), QStringList());
+
+    doneCurrent();
+    update();
+    return true;
+}
+
+void GLViewport::showPackedScene(PackedScene &&packed, const QStringList &watchPaths)
+{
+    boundingMin = packed.boundingMin;
+    boundingMax = packed.boundingMax;
+    modelCenter = packed.center;
+    modelRadius = packed.radius;
+
+    updateTexture(packed.texture);
+    uploadScene(std::move(packed));
+    resetCamera();
+    watchModelFiles(watchPaths);
+}
+
 void GLViewport::uploadMesh(const aiMesh *m)
 {
     printf("uploadMesh: vertices=%d, faces=%d\n", m->mNumVertices, m->mNumFaces);
@@ -426,7 +596,40 @@ void GLViewport::uploadMesh(const aiMesh *m)
 }
 
 /* ---------- camera controls --------------------------------------------------- */
-void GLViewport::mousePressEvent(QMouseEvent *e){ lastPos=e->pos(); }
+void GLViewport::mousePressEvent(QMouseEvent *e)
+{
+    lastPos=e->pos();
+    pressPos=e->pos();
+    activeView = viewAt(e->position());   // sürükleme/zoom bu görünümün kamerasına
+}
+
+void GLViewport::mouseReleaseEvent(QMouseEvent *e)
+{
+    // Sürüklemeden bırakılan sol tık = yüzey seçimi
+    if(e->button() == Qt::LeftButton &&
+       (e->pos() - pressPos).manhattanLength() <= 3) {
+        PickResult result = pickAt(e->position());
+        if(result.hit) {
+            printf("Pick: mesh=%d (%s), material=%s, nokta=(%.4f, %.4f, %.4f), %.1f us\n",
+                   result.meshIndex, result.meshName.toStdString().c_str(),
+                   result.materialName.toStdString().c_str(),
+                   result.position.x(), result.position.y(), result.position.z(),
+                   result.elapsedNs / 1000.0);
+            fflush(stdout);
+        }
+        emit surfacePicked(result);
+    }
+}
+
+PickResult GLViewport::pickAt(const QPointF &pos)
+{
+    // Tıklanan alt görünümün kamerası ve yerel koordinatları
+    const int index = viewAt(pos);
+    const QRect rect = viewRect(index);
+    updateView(index);
+    return Picking::pick(bvh, meshRanges, projection * view * model,
+                         pos - QPointF(rect.topLeft()), rect.size());
+}
 
 void GLViewport::mouseMoveEvent(QMouseEvent *e)
 {
@@ -434,12 +637,14 @@ void GLViewport::mouseMoveEvent(QMouseEvent *e)
         float dx = lastPos.x() - e->position().x();
         float dy = e->position().y() - lastPos.y();
         
+        ViewCamera &cam = cameras[activeView];
+
         // Daha yumuşak hareket
-        yaw += dx * 0.3f;
-        pitch += dy * 0.3f;
+        cam.yaw += dx * 0.3f;
+        cam.pitch += dy * 0.3f;
         
         // Pitch sınırla (baş aşağı döndürmeyi engelle)
-        pitch = qBound(-85.0f, pitch, 85.0f);
+        cam.pitch = qBound(-85.0f, cam.pitch, 85.0f);
         
         lastPos = e->pos();
         update();
@@ -459,13 +664,14 @@ void GLViewport::mouseMoveEvent(QMouseEvent *e)
 
 void GLViewport::wheelEvent(QWheelEvent *e)
 {
+    ViewCamera &cam = cameras[viewAt(e->position())];
     float zoomFactor = (e->angleDelta().y() > 0) ? 0.9f : 1.1f;
-    distance *= zoomFactor;
+    cam.distance *= zoomFactor;
     
     // Zoom sınırları (modele çok yakın/uzak gitmeyi engelle)
     float minDistance = modelRadius * 0.1f;
     float maxDistance = modelRadius * 10.0f;
-    distance = qBound(minDistance, distance, maxDistance);
+    cam.distance = qBound(minDistance, cam.distance, maxDistance);
     
     update();
 }
@@ -508,9 +714,7 @@ void GLViewport::calculateBoundingBox(const aiMesh *mesh)
 void GLViewport::resetCamera()
 {
     // Kamerayı modeli güzel gösterecek şekilde ayarla
-    distance = modelRadius * 2.5f; 
-    yaw = 45.0f;    
-    pitch = 10.0f;  // Daha az yukarıdan, daha çok yandan bak
+    resetViewCameras();
     
     // Model matrisini merkeze getir - Y ekseninde biraz ayarla
     model.setToIdentity();
@@ -522,7 +726,7 @@ void GLViewport::resetCamera()
     model.translate(-adjustedCenter);
     
     printf("Kamera reset edildi: distance=%.2f, yaw=%.1f, pitch=%.1f\n", 
-           distance, yaw, pitch);
+           cameras[0].distance, cameras[0].yaw, cameras[0].pitch);
     printf("Adjusted center: (%.2f, %.2f, %.2f)\n", 
            adjustedCenter.x(), adjustedCenter.y(), adjustedCenter.z());
     fflush(stdout);
@@ -554,6 +758,9 @@ bool GLViewport::loadTexture(const QString &texturePath)
 
     glBindTexture(GL_TEXTURE_2D, 0);
 
+    textureHash = HotReload::imageHash(glImage);
+    textureSize = glImage.size();
+
     printf("Texture yüklendi: %s (%dx%d)\n",
            texturePath.toStdString().c_str(),
            glImage.width(), glImage.height());
@@ -615,24 +822,13 @@ bool GLViewport::loadEmbeddedTexture(const aiTexture* aiTex)
 {
     if (!aiTex) return false;
 
-    QImage image;
-
-    // Compressed texture (PNG, JPG vs.)
-    if (aiTex->mHeight == 0) {
+    // Compressed (PNG, JPG vs.) veya uncompressed (raw RGBA) texture
+    if (aiTex->mHeight == 0)
         printf("Compressed texture yükleniyor, boyut: %d bytes\n", aiTex->mWidth);
-        QByteArray data((const char*)aiTex->pcData, aiTex->mWidth);
-        if (!image.loadFromData(data)) {
-            printf("Compressed texture yüklenemedi\n");
-            return false;
-        }
-    }
-    // Uncompressed texture (raw RGBA data)
-    else {
+    else
         printf("Uncompressed texture yükleniyor: %dx%d\n", aiTex->mWidth, aiTex->mHeight);
-        image = QImage((const uchar*)aiTex->pcData,
-                       aiTex->mWidth, aiTex->mHeight,
-                       QImage::Format_RGBA8888);
-    }
+
+    QImage image = SceneData::decodeEmbeddedTexture(aiTex);
 
     if (image.isNull()) {
         printf("Texture image oluşturulamadı\n");
@@ -652,7 +848,7 @@ bool GLViewport::loadEmbeddedTexture(const aiTexture* aiTex)
     }
 
     // QImage'ı OpenGL formatına çevir - Y eksenini çevir
-    QImage glImage = image.convertToFormat(QImage::Format_RGBA8888).mirrored();
+    QImage glImage = SceneData::toGLImage(image);
 
     // TEXTURE OLUŞTURMA ve YÜKLEME
     glGenTextures(1, &textureID);
@@ -666,7 +862,7 @@ bool GLViewport::loadEmbeddedTexture(const aiTexture* aiTex)
     // Texture parametrelerini ayarla
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     // Mipmap oluştur (isteğe bağlı ama önerilir)
@@ -683,6 +879,9 @@ bool GLViewport::loadEmbeddedTexture(const aiTexture* aiTex)
         return false;
     }
 
+    textureHash = HotReload::imageHash(glImage);
+    textureSize = glImage.size();
+
     printf("Embedded texture başarıyla yüklendi: %dx%d, OpenGL ID: %d\n",
            glImage.width(), glImage.height(), textureID);
 
@@ -698,17 +897,88 @@ void GLViewport::keyPressEvent(QKeyEvent *e)
         resetCamera(); // R tuşu ile kamerayı reset et
         update();
         break;
+    case Qt::Key_B:
+        // B tuşu ile meshlet arka yüz (normal konisi) elemeyi aç/kapat - sadece kapalı mesh'lerde güvenli
+        coneCulling = !coneCulling;
+        printf("Meshlet arka yüz eleme: %s\n", coneCulling ? "AÇIK" : "KAPALI");
+        update();
+        break;
     case Qt::Key_F:
         // F tuşu ile modeli frame'le (tam sığdır)
-        distance = modelRadius * 2.0f;
+        for(int i = 0; i < viewCount; ++i)
+            cameras[i].distance = modelRadius * 2.0f;
         update();
         break;
+    case Qt::Key_V:
+        // V tuşu ile tek / çoklu (ön-yan-arka) görünüm
+        setMultiView(!isMultiView());
+        break;
+    case Qt::Key_C:
+        // C tuşu ile kumaş simülasyonu
+        setClothSimulation(!isClothSimulation());
+        break;
     default:
         QOpenGLWidget::keyPressEvent(e);
         break;
     }
 }
 
+void GLViewport::resetViewCameras()
+{
+    if(viewCount == 1) {
+        cameras[0].yaw = 45.0f;
+        cameras[0].pitch = 10.0f;  // Daha az yukarıdan, daha çok yandan bak
+    } else {
+        // +Z önü: ön, yan, arka
+        for(int i = 0; i < viewCount; ++i) {
+            cameras[i].yaw = 90.0f * i;
+            cameras[i].pitch = 10.0f;
+        }
+    }
+    for(int i = 0; i < viewCount; ++i)
+        cameras[i].distance = modelRadius * 2.5f;
+}
+
+void GLViewport::setMultiView(bool enabled)
+{
+    if(enabled == isMultiView()) return;
+
+    viewCount = enabled ? kMaxViews : 1;
+    activeView = 0;
+    resetViewCameras();
+    printf("Görünüm: %s\n", enabled ? "çoklu (ön/yan/arka)" : "tek");
+    fflush(stdout);
+
+    emit multiViewChanged(enabled);
+    update();
+}
+
+void GLViewport::setClothSimulation(bool enabled)
+{
+    if(enabled == clothEnabled) return;
+
+    makeCurrent();
+    clothEnabled = enabled;
+    if(enabled) clothEnabled = startCloth();
+    else stopCloth(true);
+    doneCurrent();
+
+    printf("Kumaş simülasyonu: %s\n", clothEnabled ? "AÇIK" : "KAPALI");
+    fflush(stdout);
+
+    emit clothSimulationChanged(clothEnabled);
+    update();
+}
+
+bool GLViewport::shouldUseMeshlets(int triangleCount)
+{
+    // DESKTOPVIEWER_MESHLETS=1 her zaman, =0 hiçbir zaman; yoksa üçgen sayısına göre
+    bool ok = false;
+    const int forced = qEnvironmentVariableIntValue("DESKTOPVIEWER_MESHLETS", &ok);
+    if (ok) return forced != 0;
+    return triangleCount >= kMeshletTriangleThreshold;
+}
+
 void GLViewport::checkTextureStatus()
 {
     printf("=== TEXTURE STATUS DEBUG ===\n");
@@ -743,37 +1013,353 @@ void GLViewport::calculateBoundingBoxForScene(const aiScene *scene)
 {
     if (!scene || scene->mNumMeshes == 0) return;
 
-    bool first = true;
-    
-    for (unsigned int mIdx = 0; mIdx < scene->mNumMeshes; ++mIdx) {
-        const aiMesh *mesh = scene->mMeshes[mIdx];
-        if (!mesh || mesh->mNumVertices == 0) continue;
+    PackedScene bounds;
+    SceneData::computeBounds(scene, bounds);
+
+    boundingMin = bounds.boundingMin;
+    boundingMax = bounds.boundingMax;
 
-        for (unsigned i = 0; i < mesh->mNumVertices; ++i) {
-            QVector3D vertex(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
-            
-            if (first) {
-                boundingMin = boundingMax = vertex;
-                first = false;
-            } else {
-                boundingMin.setX(qMin(boundingMin.x(), vertex.x()));
-                boundingMin.setY(qMin(boundingMin.y(), vertex.y()));
-                boundingMin.setZ(qMin(boundingMin.z(), vertex.z()));
-                
-                boundingMax.setX(qMax(boundingMax.x(), vertex.x()));
-                boundingMax.setY(qMax(boundingMax.y(), vertex.y()));
-                boundingMax.setZ(qMax(boundingMax.z(), vertex.z()));
-            }
-        }
-    }
-    
     // Model merkezi ve yarıçapı
-    modelCenter = (boundingMin + boundingMax) * 0.5f;
+    modelCenter = bounds.center;
+    modelRadius = bounds.radius;
     QVector3D size = boundingMax - boundingMin;
-    modelRadius = qMax(qMax(size.x(), size.y()), size.z()) * 0.6f;
-    
+
     printf("Scene Bounding Box:\n");
     printf("  Center: (%.2f, %.2f, %.2f)\n", modelCenter.x(), modelCenter.y(), modelCenter.z());
     printf("  Radius: %.2f\n", modelRadius);
     printf("  Size: (%.2f, %.2f, %.2f)\n", size.x(), size.y(), size.z());
-}
\ No newline at end of file
+}
+
+/* ---------- hot reload -------------------------------------------------------- */
+void GLViewport::watchModelFiles(const QStringList &paths)
+{
+    const QStringList watched = fileWatcher.files();
+    if(!watched.isEmpty()) fileWatcher.removePaths(watched);
+    watchedFiles = paths;
+    if(!paths.isEmpty()) fileWatcher.addPaths(paths);
+}
+
+void GLViewport::startReload()
+{
+    if(currentModelPath.isEmpty()) return;
+
+    // Atomik kaydetme (yeni dosya + rename) izlemeyi düşürür - tekrar ekle
+    const QStringList watched = fileWatcher.files();
+    for(const QString &path : watchedFiles)
+        if(!watched.contains(path) && QFileInfo::exists(path))
+            fileWatcher.addPath(path);
+
+    if(reloadThread) {
+        // Önceki import bitince bir kez daha
+        reloadQueued = true;
+        return;
+    }
+
+    const QString path = currentModelPath;
+    auto result = std::make_shared<ReloadResult>();
+    reloadThread = QThread::create([path, result]() {
+        if(HotReload::reimport(path, *result) && shouldUseMeshlets(result->scene.triangleCount()))
+            result->meshlets = Meshlets::build(result->scene, result->bvh);
+    });
+    connect(reloadThread, &QThread::finished, this, [this, result]() {
+        reloadThread->deleteLater();
+        reloadThread = nullptr;
+
+        applyReload(*result);
+
+        if(reloadQueued) {
+            reloadQueued = false;
+            reloadTimer.start();
+        }
+    });
+    reloadThread->start();
+}
+
+void GLViewport::applyReload(ReloadResult &result)
+{
+    if(!result.ok) return;
+    if(result.path != currentModelPath) return;   // bu arada başka model seçildi
+
+    QElapsedTimer timer;
+    timer.start();
+    makeCurrent();
+
+    // Kamera ve model matrisi korunur; sadece zoom sınırları için bounds güncellenir
+    boundingMin = result.scene.boundingMin;
+    boundingMax = result.scene.boundingMax;
+    modelRadius = result.scene.radius;
+
+    bvh = std::move(result.bvh);
+    meshRanges = result.scene.meshes;
+
+    updateTexture(result.scene.texture);
+
+    if(!result.meshlets.isEmpty()) {
+        indexCount = static_cast<int>(result.scene.idx.size());
+        meshletRenderer.setScene(std::move(result.scene), std::move(result.meshlets),
+                                 MeshletRenderer::budgetFromEnvironment());
+        if(!useMeshlets) {
+            glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            vboSignature = eboSignature = aoSignature = HotReload::BufferSignature();
+            clearInstances();
+        }
+        useMeshlets = true;
+    } else if(useMeshlets) {
+        meshletRenderer.clear();
+        useMeshlets = false;
+        uploadPackedScene(result.scene);
+    } else {
+        updatePackedScene(result.scene);
+    }
+
+    resetCloth();
+    watchModelFiles(result.watchPaths);
+    doneCurrent();
+    update();
+
+    printf("Hot reload: %s (import %lld ms, GPU güncelleme %lld ms)\n",
+           result.path.toStdString().c_str(), result.importMs, timer.elapsed());
+    fflush(stdout);
+}
+
+size_t GLViewport::updateBuffer(GLenum target, GLuint buffer, const void *data, size_t bytes,
+                                HotReload::BufferSignature &resident)
+{
+    HotReload::BufferSignature incoming = HotReload::signature(data, bytes);
+    const std::vector<HotReload::Range> ranges = HotReload::changedRanges(resident, incoming);
+
+    glBindBuffer(target, buffer);
+    size_t uploaded = 0;
+    if(resident.bytes != bytes) {
+        // Boyut değişti - yeniden ayır
+        glBufferData(target, GLsizeiptr(bytes), data, GL_STATIC_DRAW);
+        uploaded = bytes;
+    } else {
+        // Aynı boyut - sadece değişen chunk'lar yerinde
+        for(const HotReload::Range &r : ranges) {
+            glBufferSubData(target, GLintptr(r.offset), GLsizeiptr(r.bytes),
+                            static_cast<const char*>(data) + r.offset);
+            uploaded += r.bytes;
+        }
+    }
+    resident = std::move(incoming);
+    return uploaded;
+}
+
+void GLViewport::updatePackedScene(const PackedScene &packed)
+{
+    if(packed.isEmpty()) return;
+
+    const bool instanced = !packed.instanced.isEmpty();
+    const std::vector<float>    &verts = instanced ? packed.instanced.verts : packed.verts;
+    const std::vector<unsigned> &idx   = instanced ? packed.instanced.idx   : packed.idx;
+    const std::vector<float>    &ao    = instanced ? packed.instanced.ao    : packed.ao;
+    indexCount = static_cast<int>(idx.size());
+
+    // Element buffer bağlantısı VAO durumunun parçası
+    glBindVertexArray(vao);
+    size_t uploaded = 0;
+    uploaded += updateBuffer(GL_ARRAY_BUFFER, vbo, verts.data(),
+                             verts.size() * sizeof(float), vboSignature);
+    uploaded += updateBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo, idx.data(),
+                             idx.size() * sizeof(unsigned), eboSignature);
+
+    if(ao.size() == verts.size() / PackedScene::kFloatsPerVertex) {
+        uploaded += updateBuffer(GL_ARRAY_BUFFER, aoVbo, ao.data(),
+                                 ao.size() * sizeof(float), aoSignature);
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
+        glEnableVertexAttribArray(3);
+    } else {
+        glDisableVertexAttribArray(3);
+        aoSignature = HotReload::BufferSignature();
+    }
+    glBindVertexArray(0);
+
+    // Instance matrisleri küçük - her seferinde tamamı
+    if(instanced) uploadInstances(packed.instanced);
+    else clearInstances();
+
+    const size_t total = (verts.size() + ao.size()) * sizeof(float) + idx.size() * sizeof(unsigned);
+    printf("Hot reload buffer: %.2f / %.2f MB yüklendi\n",
+           uploaded / (1024.0 * 1024.0), total / (1024.0 * 1024.0));
+}
+
+void GLViewport::updateTexture(const QImage &glImage)
+{
+    if(glImage.isNull()) {
+        if(hasLoadedTexture && textureID > 0) {
+            glDeleteTextures(1, &textureID);
+            textureID = 0;
+        }
+        hasLoadedTexture = false;
+        textureHash = 0;
+        textureSize = QSize();
+        return;
+    }
+
+    const size_t hash = HotReload::imageHash(glImage);
+    if(hasLoadedTexture && hash == textureHash && glImage.size() == textureSize) {
+        printf("Hot reload texture: değişmedi\n");
+        return;
+    }
+
+    if(hasLoadedTexture && textureID > 0 && glImage.size() == textureSize) {
+        // Aynı boyut - depolamayı yeniden ayırmadan içeriği değiştir
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, glImage.width(), glImage.height(),
+                        GL_RGBA, GL_UNSIGNED_BYTE, glImage.constBits());
+    } else {
+        if(textureID > 0) glDeleteTextures(1, &textureID);
+        glGenTextures(1, &textureID);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, glImage.width(), glImage.height(), 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, glImage.constBits());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    hasLoadedTexture = true;
+    textureHash = hash;
+    textureSize = glImage.size();
+    printf("Hot reload texture: güncellendi (%dx%d)\n", glImage.width(), glImage.height());
+}
+
+/* ---------- Kumaş simülasyonu ------------------------------------------------- */
+bool GLViewport::startCloth()
+{
+    if(indexCount == 0) return false;
+    if(useMeshlets) {
+        printf("Kumaş: meshlet sahnelerde desteklenmiyor\n");
+        return false;
+    }
+
+    // Dinlenme pozu GPU'dan geri okunur - CPU'da ikinci kopya tutulmuyor
+    GLint vboBytes = 0;
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &vboBytes);
+    clothRestVerts.resize(size_t(vboBytes) / sizeof(float));
+    glGetBufferSubData(GL_ARRAY_BUFFER, 0, vboBytes, clothRestVerts.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Element buffer bağlantısı VAO durumunun parçası
+    std::vector<unsigned> idx(size_t(indexCount));
+    glBindVertexArray(vao);
+    glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, GLsizeiptr(idx.size() * sizeof(unsigned)), idx.data());
+    GLint aoEnabled = 0;
+    glGetVertexAttribiv(3, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &aoEnabled);
+    glBindVertexArray(0);
+
+    if(!instanceBatches.empty()) {
+        // Instanced kopyalar aynı vertex'leri paylaşır, ayrı ayrı dökülemez: kumaş
+        // açıkken sahne dünya uzayına açılıp düz düzen çizilir, kapatınca geri yüklenir
+        PackedScene::Instanced &inst = clothScene.instanced;
+        inst.verts.swap(clothRestVerts);
+        inst.idx.swap(idx);
+        inst.batches = instanceBatches;
+        auto readBack = [this](GLuint buffer) {
+            GLint bytes = 0;
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &bytes);
+            std::vector<float> data(size_t(bytes) / sizeof(float));
+            glGetBufferSubData(GL_ARRAY_BUFFER, 0, bytes, data.data());
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            return data;
+        };
+        inst.transforms = readBack(instanceVbo);
+        if(aoEnabled) inst.ao = readBack(aoVbo);
+        SceneData::flattenInstances(clothScene);
+
+        // instanced kısmı boşken yüklenir: düz buffer'lar, instance dizileri kapanır
+        PackedScene::Instanced saved = std::move(inst);
+        inst = PackedScene::Instanced();
+        uploadPackedScene(clothScene);
+        inst = std::move(saved);
+
+        clothRestVerts.swap(clothScene.verts);
+        idx = clothScene.idx;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    if(!cloth.build(clothRestVerts, idx)) {
+        stopCloth(true);
+        return false;
+    }
+    printf("Kumaş kuruldu: %lld ms\n", timer.elapsed());
+    fflush(stdout);
+
+    clothVerts = clothRestVerts;
+    clothFrames = 0;
+    clothReport.start();
+    clothTimer.start();
+    return true;
+}
+
+void GLViewport::stopCloth(bool restore)
+{
+    clothTimer.stop();
+    if(restore && !clothScene.instanced.isEmpty()) {
+        // Düzleştirilmiş sahne yerine orijinal instanced düzen
+        clothScene.verts.swap(clothRestVerts);
+        uploadPackedScene(clothScene);
+    } else if(restore && !cloth.isEmpty() && !clothRestVerts.empty()) {
+        const size_t bytes = clothRestVerts.size() * sizeof(float);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(bytes), clothRestVerts.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        vboSignature = HotReload::signature(clothRestVerts.data(), bytes);
+    }
+    cloth.clear();
+    clothScene = PackedScene();
+    clothRestVerts = std::vector<float>();
+    clothVerts = std::vector<float>();
+}
+
+void GLViewport::resetCloth()
+{
+    // Yeni/güncellenen sahne: eski parçacıklar geçersiz, açıksa yeni veriden baştan
+    if(!clothEnabled) return;
+    stopCloth(false);
+    if(startCloth()) return;
+
+    clothEnabled = false;
+    emit clothSimulationChanged(false);
+}
+
+void GLViewport::stepCloth()
+{
+    if(cloth.isEmpty()) return;
+
+    cloth.step(kClothIntervalMs / 1000.0f);
+    cloth.writeVertices(clothVerts);
+
+    // Orphaning: sürücü önceki karenin hâlâ okuduğu belleği beklemeden yeni alan verir
+    const GLsizeiptr bytes = GLsizeiptr(clothVerts.size() * sizeof(float));
+    makeCurrent();
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, clothVerts.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    doneCurrent();
+    // GPU'daki içerik artık dinlenme pozu değil - hot reload tamamını yüklesin
+    vboSignature = HotReload::BufferSignature();
+    update();
+
+    ++clothFrames;
+    if(clothReport.elapsed() >= 1000) {
+        const ClothSimulation::StepStats &stats = cloth.stats();
+        printf("Kumaş: adım %.2f ms (ort. %.2f ms), %d substep, %d thread, %d parçacık, %d kısıt / %d renk, %.0f kare/s\n",
+               stats.lastMs, stats.averageMs, stats.substeps, stats.threads,
+               cloth.particleCount(), cloth.constraintCount(), cloth.colorCount(),
+               clothFrames * 1000.0 / clothReport.elapsed());
+        fflush(stdout);
+        clothFrames = 0;
+        clothReport.restart();
+    }
+}
@@ -7,9 +7,19 @@
 #include <QImage>
 #include <QFileInfo>
 #include <QFile>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QThread>
+#include <QElapsedTimer>
+#include <memory>
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
+#include "scenedata.h"
+#include "picking.h"
+#include "meshletrenderer.h"
+#include "hotreload.h"
+#include "cloth.h"
 
 class GLViewport : public QOpenGLWidget,
                    protected QOpenGLFunctions_3_3_Core
@@ -17,22 +27,49 @@ class GLViewport : public QOpenGLWidget,
     Q_OBJECT
 public:
     explicit GLViewport(QWidget *parent=nullptr);
+    ~GLViewport() override;
     bool loadModel(const QString &filePath);
+    // Katalog bundle'ından hazır sahne: import/parse yok, dosya izlenmez
+    bool loadPackedModel(const QString &name, PackedScene &&packed);
+
+    PickResult pickAt(const QPointF &pos);
+
+    // Ön/yan/arka görünümleri aynı widget'ta yan yana göster
+    void setMultiView(bool enabled);
+    bool isMultiView() const { return viewCount > 1; }
+
+    // Yüklü giysiyi kumaş olarak askıda drape et (tekrar yüklemede yeniden başlar)
+    void setClothSimulation(bool enabled);
+    bool isClothSimulation() const { return clothEnabled; }
+
+signals:
+    void surfacePicked(const PickResult &result);
+    void multiViewChanged(bool enabled);
+    void clothSimulationChanged(bool enabled);
 
 protected:
     void initializeGL() override;
-    void resizeGL(int w,int h) override;
     void paintGL() override;
 
     void mousePressEvent(QMouseEvent *e) override;
     void mouseMoveEvent(QMouseEvent *e)  override;
+    void mouseReleaseEvent(QMouseEvent *e) override;
     void wheelEvent(QWheelEvent *e)      override;
     void keyPressEvent(QKeyEvent *e) override;
 
 private:
-    void updateView();
+    void updateView(int index);
+    void drawView(int index);
+    QRect viewRect(int index) const;
+    int  viewAt(const QPointF &pos) const;
+    void resetViewCameras();
     void uploadMesh(const aiMesh *mesh);
     void uploadAllMeshes(const aiScene *scene);
+    void uploadScene(PackedScene &&packed);
+    void showPackedScene(PackedScene &&packed, const QStringList &watchPaths);
+    void uploadPackedScene(const PackedScene &packed);
+    void uploadInstances(const PackedScene::Instanced &instanced);
+    void clearInstances();
     void calculateBoundingBox(const aiMesh *mesh);
     void resetCamera();
     bool loadTexture(const QString &texturePath);
@@ -40,15 +77,51 @@ private:
     void calculateBoundingBoxForScene(const aiScene *scene);
     bool loadEmbeddedTexture(const aiTexture* aiTex);
     void checkTextureStatus();
+    static bool shouldUseMeshlets(int triangleCount);
+
+    // Hot reload: dosya izleme -> debounce -> arka planda import -> fark yükleme
+    void watchModelFiles(const QStringList &paths);
+    void startReload();
+    void applyReload(ReloadResult &result);
+    void updatePackedScene(const PackedScene &packed);
+    size_t updateBuffer(GLenum target, GLuint buffer, const void *data, size_t bytes,
+                        HotReload::BufferSignature &resident);
+    void updateTexture(const QImage &glImage);
+
+    // Kumaş: GPU'daki buffer'lardan kurulur, her karede VBO'ya akıtılır
+    bool startCloth();
+    void stopCloth(bool restore);
+    void resetCloth();
+    void stepCloth();
     
     QOpenGLShaderProgram shader;
-    GLuint vao=0, vbo=0, ebo=0;
+    GLuint vao=0, vbo=0, ebo=0, aoVbo=0;
+    // Tekrar eden mesh'lerin instance matrisleri (location 4-7) ve normal
+    // matrisleri (location 8-10, CPU'da ters-devrik); boşsa tek çizim
+    GLuint instanceVbo=0, instanceNormalVbo=0;
+    std::vector<PackedScene::Instanced::Batch> instanceBatches;
     GLuint textureID = 0;
     int    indexCount=0;
     bool   hasLoadedTexture = false;
+    QString currentModelPath;
+
+    // Her alt görünümün kendi kamerası; GL kaynakları (shader, buffer, texture) ortak.
+    // Ek görünüm = sadece bir çizim geçişi daha (yeniden import/upload yok).
+    struct ViewCamera {
+        const char *name;
+        float yaw, pitch, distance;
+    };
+    static constexpr int kMaxViews = 3;
+    ViewCamera cameras[kMaxViews] = {
+        {"Ön",   0.0f,   10.0f, 3.0f},
+        {"Yan",  90.0f,  10.0f, 3.0f},
+        {"Arka", 180.0f, 10.0f, 3.0f},
+    };
+    int viewCount = 1;
+    int activeView = 0;   // fare ile kontrol edilen görünüm
 
-    float distance=3.0f, yaw=0.0f, pitch=0.0f;
     QPoint lastPos;
+    QPoint pressPos;
 
     QMatrix4x4 projection, view, model;
     
@@ -56,5 +129,37 @@ private:
     float modelRadius = 1.0f;
     QVector3D boundingMin, boundingMax;
 
+    // Picking: yüklemede kurulan BVH ve üçgen -> aiMesh eşlemesi
+    TriangleBVH bvh;
+    std::vector<PackedScene::MeshRange> meshRanges;
+
+    // Çok büyük taramalar: meshlet + CPU culling + streaming
+    static constexpr int kMeshletTriangleThreshold = 1000000;
+    MeshletRenderer meshletRenderer;
+    bool useMeshlets = false;
+    bool coneCulling = false;   // açık giysilerde iç yüz görünür - B ile isteğe bağlı
+
+    // Hot reload durumu. Signature'lar GPU'daki buffer/texture içeriğinin hash'leri.
+    static constexpr int kReloadDebounceMs = 300;
+    QFileSystemWatcher fileWatcher;
+    QStringList watchedFiles;
+    QTimer reloadTimer;
+    QThread *reloadThread = nullptr;
+    bool reloadQueued = false;
+    HotReload::BufferSignature vboSignature, eboSignature, aoSignature;
+    size_t textureHash = 0;
+    QSize  textureSize;
+
+    // Kumaş simülasyonu. Picking/AO dinlenme pozundaki BVH ile devam eder.
+    static constexpr int kClothIntervalMs = 16;
+    ClothSimulation cloth;
+    QTimer clothTimer;
+    bool   clothEnabled = false;
+    std::vector<float> clothRestVerts;   // durdurunca geri yüklenir
+    PackedScene clothScene;              // instanced sahnede düz idx/ao + kapatınca geri yüklenen instanced düzen
+    std::vector<float> clothVerts;
+    QElapsedTimer clothReport;
+    int    clothFrames = 0;
+
     Assimp::Importer importer;
 };
@@ -0,0 +1,90 @@
+#include "hotreload.h"
+#include "aobake.h"
+#include "picking.h"
+#include "mmapiosystem.h"
+#include "objloader.h"
+#include "parallel.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+HotReload::BufferSignature HotReload::signature(const void *data, size_t bytes)
+{
+    BufferSignature sig;
+    sig.bytes = bytes;
+    sig.chunks.resize((bytes + kChunkBytes - 1) / kChunkBytes);
+
+    const char *base = static_cast<const char*>(data);
+    parallelFor(sig.chunks.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            const size_t offset = c * kChunkBytes;
+            sig.chunks[c] = qHashBits(base + offset, qMin(kChunkBytes, bytes - offset));
+        }
+    });
+    return sig;
+}
+
+std::vector<HotReload::Range> HotReload::changedRanges(const BufferSignature &resident,
+                                                      const BufferSignature &incoming)
+{
+    std::vector<Range> ranges;
+    if (resident.bytes != incoming.bytes) {
+        ranges.push_back({0, incoming.bytes});
+        return ranges;
+    }
+
+    for (size_t c = 0; c < incoming.chunks.size(); ++c) {
+        if (resident.chunks[c] == incoming.chunks[c]) continue;
+
+        const size_t offset = c * kChunkBytes;
+        const size_t bytes = qMin(kChunkBytes, incoming.bytes - offset);
+        if (!ranges.empty() && ranges.back().offset + ranges.back().bytes == offset)
+            ranges.back().bytes += bytes;
+        else
+            ranges.push_back({offset, bytes});
+    }
+    return ranges;
+}
+
+size_t HotReload::imageHash(const QImage &image)
+{
+    if (image.isNull()) return 0;
+    return qHashBits(image.constBits(), size_t(image.sizeInBytes()));
+}
+
+bool HotReload::reimport(const QString &path, ReloadResult &out)
+{
+    QElapsedTimer timer;
+    timer.start();
+    out.path = path;
+
+    QStringList dependencies;
+    Assimp::Importer importer;
+    if (ObjLoader::isEnabledFor(path) && ObjLoader::load(path, out.scene, &dependencies)) {
+        out.watchPaths = QStringList{path} + dependencies;
+    } else {
+        MappedIOSystem::install(importer, path);
+        const aiScene *scene = importer.ReadFile(path.toStdString(), SceneData::importFlags());
+        if (!scene || !scene->HasMeshes()) {
+            printf("Hot reload import hatası (%s): %s\n",
+                   path.toStdString().c_str(), importer.GetErrorString());
+            return false;
+        }
+
+        SceneData::computeBounds(scene, out.scene);
+        SceneData::packMeshes(scene, out.scene);
+        SceneData::buildInstancing(scene, out.scene);
+        out.scene.texture = SceneData::findDiffuseTexture(scene, path);
+        out.watchPaths = QStringList{path} + SceneData::externalTexturePaths(scene, path);
+    }
+
+    // Model değiştiyse cache anahtarı (boyut + mtime) da değişir - yeniden kurulur
+    Picking::loadOrBuildBVH(out.bvh, out.scene, path);
+    AmbientOcclusion::loadOrBake(out.scene, path, &out.bvh);
+    SceneData::resolveInstanceAo(out.scene);
+
+    out.ok = !out.scene.isEmpty();
+    out.importMs = timer.elapsed();
+    return out.ok;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <vector>
+#include "scenedata.h"
+#include "bvh.h"
+#include "meshlets.h"
+
+// Arka planda yeniden import edilmiş model - GUI thread'de yerleşik
+// buffer'larla karşılaştırılıp sadece değişen kısımlar yüklenir.
+struct ReloadResult
+{
+    QString     path;
+    bool        ok = false;
+    PackedScene scene;
+    TriangleBVH bvh;
+    MeshletData meshlets;     // boşsa monolitik buffer yolu
+    QStringList watchPaths;   // model + dış texture dosyaları
+    qint64      importMs = 0;
+};
+
+namespace HotReload
+{
+    constexpr size_t kChunkBytes = 64 * 1024;
+
+    // GPU'daki buffer'ın chunk hash'leri - CPU kopyası tutmadan fark çıkarmak için
+    struct BufferSignature
+    {
+        size_t              bytes = 0;
+        std::vector<size_t> chunks;
+    };
+
+    struct Range
+    {
+        size_t offset;
+        size_t bytes;
+    };
+
+    BufferSignature signature(const void *data, size_t bytes);
+
+    // Boyut aynıysa değişen chunk'lar (bitişik olanlar birleştirilir)
+    std::vector<Range> changedRanges(const BufferSignature &resident, const BufferSignature &incoming);
+
+    size_t imageHash(const QImage &image);
+
+    // İş parçacığında çağrılır: kendi importer'ı ile oku, paketle, BVH + AO
+    bool reimport(const QString &path, ReloadResult &out);
+}
@@ -1,7 +1,51 @@
 #include <QApplication>
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <cstring>
 #include "desktopviewer.h"
+#include "batchrenderer.h"
+#include "renderserver.h"
+#include "catalogbundle.h"
+
+static bool hasFlag(int argc, char *argv[], const char *flag)
+{
+    for (int i = 1; i < argc; ++i)
+        if (strcmp(argv[i], flag) == 0) return true;
+    return false;
+}
 
 int main(int argc, char *argv[]) {
+    // Headless toplu render: pencere açılmaz (ekransız makinede -platform offscreen)
+    if (hasFlag(argc, argv, "--batch")) {
+        QGuiApplication app(argc, argv);
+
+        BatchJob job;
+        QString error;
+        if (!BatchRenderer::parseArguments(app.arguments(), job, &error)) {
+            fprintf(stderr, "Batch argüman hatası: %s\n", error.toStdString().c_str());
+            return 2;
+        }
+        return BatchRenderer(job).run() == 0 ? 0 : 1;
+    }
+
+    // Katalog dizinini tek bundle dosyasına paketle (thumbnail için offscreen GL)
+    if (hasFlag(argc, argv, "--pack")) {
+        QGuiApplication app(argc, argv);
+        return CatalogBundle::pack(app.arguments());
+    }
+
+    // Yerel render sunucusu: JSON istekleri soket üzerinden, kareler soket/shm ile
+    if (hasFlag(argc, argv, "--serve")) {
+        QGuiApplication app(argc, argv);
+        return RenderServer::run(app.arguments());
+    }
+
+    // Sunucu için yük/gecikme test istemcisi (GL gerekmez)
+    if (hasFlag(argc, argv, "--client")) {
+        QCoreApplication app(argc, argv);
+        return RenderClient::run(app.arguments());
+    }
+
     QApplication app(argc, argv);
 
     DesktopViewer viewer;
@@ -10,4 +54,3 @@ int main(int argc, char *argv[]) {
 
     return app.exec();
 }
-
@@ -0,0 +1,206 @@
+#include "meshletrenderer.h"
+#include <QtGlobal>
+#include <algorithm>
+
+void MeshletRenderer::initialize(QOpenGLFunctions_3_3_Core *functions)
+{
+    gl = functions;
+    gl->glGenVertexArrays(1, &vao);
+    gl->glGenBuffers(1, &vbo);
+    gl->glGenBuffers(1, &ebo);
+
+    gl->glBindVertexArray(vao);
+    gl->glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    gl->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+    // position(3) + texCoord(2) + normal(3) + ao(1)
+    const GLsizei stride = kFloatsPerVertex * sizeof(float);
+    gl->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    gl->glEnableVertexAttribArray(0);
+    gl->glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
+    gl->glEnableVertexAttribArray(1);
+    gl->glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(5 * sizeof(float)));
+    gl->glEnableVertexAttribArray(2);
+    gl->glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)(8 * sizeof(float)));
+    gl->glEnableVertexAttribArray(3);
+
+    gl->glBindVertexArray(0);
+}
+
+void MeshletRenderer::release()
+{
+    if (!gl) return;
+    gl->glDeleteBuffers(1, &vbo);
+    gl->glDeleteBuffers(1, &ebo);
+    gl->glDeleteVertexArrays(1, &vao);
+    vao = vbo = ebo = 0;
+    gl = nullptr;
+}
+
+size_t MeshletRenderer::budgetFromEnvironment()
+{
+    bool ok = false;
+    const int mb = qEnvironmentVariableIntValue("DESKTOPVIEWER_VRAM_MB", &ok);
+    return size_t(ok && mb > 0 ? mb : 512) * 1024 * 1024;
+}
+
+void MeshletRenderer::clear()
+{
+    scene = PackedScene();
+    data = MeshletData();
+    slotCount = 0;
+    slotOf.clear();
+    meshletInSlot.clear();
+    lastUsed.clear();
+    freeSlots.clear();
+
+    if (gl) {
+        // VRAM'i hemen geri ver
+        gl->glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        gl->glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+        gl->glBindVertexArray(vao);
+        gl->glBufferData(GL_ELEMENT_ARRAY_BUFFER, 0, nullptr, GL_STATIC_DRAW);
+        gl->glBindVertexArray(0);
+    }
+}
+
+void MeshletRenderer::setScene(PackedScene &&newScene, MeshletData &&newMeshlets, size_t budgetBytes)
+{
+    clear();
+    scene = std::move(newScene);
+    data = std::move(newMeshlets);
+
+    const size_t vertexBytes = size_t(Meshlets::kMaxVertices) * kFloatsPerVertex * sizeof(float);
+    const size_t indexBytes  = size_t(Meshlets::kMaxTriangles) * 3 * sizeof(uint32_t);
+    slotCount = std::min(data.meshlets.size(), std::max<size_t>(1, budgetBytes / (vertexBytes + indexBytes)));
+
+    slotOf.assign(data.meshlets.size(), kNotResident);
+    meshletInSlot.assign(slotCount, kNotResident);
+    lastUsed.assign(slotCount, 0);
+    freeSlots.resize(slotCount);
+    for (size_t i = 0; i < slotCount; ++i)
+        freeSlots[i] = uint32_t(slotCount - 1 - i);
+    frameIndex = 0;
+    clockHand = 0;
+    budgetReported = false;
+
+    gl->glBindVertexArray(vao);
+    gl->glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    gl->glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(slotCount * vertexBytes), nullptr, GL_DYNAMIC_DRAW);
+    gl->glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(slotCount * indexBytes), nullptr, GL_DYNAMIC_DRAW);
+    gl->glBindVertexArray(0);
+
+    printf("Meshlet: %d küme, %zu slot (%.1f MB), model %s\n",
+           int(data.meshlets.size()), slotCount,
+           slotCount * (vertexBytes + indexBytes) / (1024.0 * 1024.0),
+           slotCount < data.meshlets.size() ? "VRAM bütçesinden büyük - streaming" : "tamamen sığıyor");
+}
+
+uint32_t MeshletRenderer::acquireSlot(uint32_t frame)
+{
+    if (!freeSlots.empty()) {
+        const uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    // Saat (clock) algoritması: bu karede kullanılmayan ilk slotu çıkar - yaklaşık LRU, O(1)
+    for (size_t tries = 0; tries < slotCount; ++tries) {
+        const uint32_t slot = clockHand;
+        clockHand = uint32_t((clockHand + 1) % slotCount);
+        if (lastUsed[slot] == frame) continue;
+
+        if (meshletInSlot[slot] != kNotResident)
+            slotOf[meshletInSlot[slot]] = kNotResident;
+        meshletInSlot[slot] = kNotResident;
+        return slot;
+    }
+    return kNotResident;   // görünür küme bütçeden büyük
+}
+
+void MeshletRenderer::uploadMeshlet(uint32_t meshletIndex, uint32_t slot)
+{
+    const Meshlet &m = data.meshlets[meshletIndex];
+    const bool hasAo = scene.ao.size() == size_t(scene.vertexCount());
+
+    staging.resize(size_t(m.vertexCount) * kFloatsPerVertex);
+    float *dst = staging.data();
+    for (uint32_t i = 0; i < m.vertexCount; ++i) {
+        const uint32_t v = data.vertices[m.vertexOffset + i];
+        const float *src = scene.verts.data() + size_t(v) * PackedScene::kFloatsPerVertex;
+        std::copy(src, src + PackedScene::kFloatsPerVertex, dst);
+        dst[PackedScene::kFloatsPerVertex] = hasAo ? scene.ao[v] : 1.0f;
+        dst += kFloatsPerVertex;
+    }
+
+    const size_t vertexBytes = size_t(Meshlets::kMaxVertices) * kFloatsPerVertex * sizeof(float);
+    const size_t indexBytes  = size_t(Meshlets::kMaxTriangles) * 3 * sizeof(uint32_t);
+    gl->glBufferSubData(GL_ARRAY_BUFFER, GLintptr(slot * vertexBytes),
+                        GLsizeiptr(staging.size() * sizeof(float)), staging.data());
+    gl->glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, GLintptr(slot * indexBytes),
+                        GLsizeiptr(size_t(m.triangleCount) * 3 * sizeof(uint32_t)),
+                        data.indices.data() + size_t(m.triangleOffset) * 3);
+
+    slotOf[meshletIndex] = slot;
+    meshletInSlot[slot] = meshletIndex;
+}
+
+MeshletRenderer::FrameStats MeshletRenderer::draw(const QMatrix4x4 &mvp, const QVector3D &cameraPos, bool coneCulling)
+{
+    FrameStats stats;
+    if (!isActive() || !gl) return stats;
+
+    // 0 "hiç kullanılmadı" anlamına geliyor - beginFrame() çağrılmadıysa da geçerli olsun
+    if (frameIndex == 0) frameIndex = 1;
+    const uint32_t frame = frameIndex;
+
+    Meshlets::cull(data, mvp, cameraPos, coneCulling, visible);
+    stats.visible = int(visible.size());
+
+    // Yüklü olanları bu karede kullanılmış say - tahliye edilmesinler
+    for (uint32_t m : visible)
+        if (slotOf[m] != kNotResident) lastUsed[slotOf[m]] = frame;
+
+    gl->glBindVertexArray(vao);
+    gl->glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    const size_t indexBytes = size_t(Meshlets::kMaxTriangles) * 3 * sizeof(uint32_t);
+    counts.clear();
+    offsets.clear();
+    baseVertices.clear();
+
+    for (uint32_t m : visible) {
+        uint32_t slot = slotOf[m];
+        if (slot == kNotResident) {
+            if (stats.uploaded >= kMaxUploadsPerFrame) {
+                stats.pending++;
+                continue;
+            }
+            if ((slot = acquireSlot(frame)) == kNotResident) {
+                stats.overBudget++;
+                continue;
+            }
+            uploadMeshlet(m, slot);
+            lastUsed[slot] = frame;
+            stats.uploaded++;
+        }
+
+        // Sıkıştırılmış çizim listesi
+        counts.push_back(GLsizei(data.meshlets[m].triangleCount * 3));
+        offsets.push_back(reinterpret_cast<void*>(size_t(slot) * indexBytes));
+        baseVertices.push_back(GLint(slot * Meshlets::kMaxVertices));
+    }
+
+    stats.drawn = int(counts.size());
+    if (stats.overBudget > 0 && !budgetReported) {
+        // Tekrar çizmek yer açmaz - sadece bildir, kamera değişince yeniden denenir
+        printf("Meshlet: görünür %d küme %zu slota sığmıyor, %d küme çizilmedi (DESKTOPVIEWER_VRAM_MB)\n",
+               stats.visible, slotCount, stats.overBudget);
+        budgetReported = true;
+    }
+    if (!counts.empty())
+        gl->glMultiDrawElementsBaseVertex(GL_TRIANGLES, counts.data(), GL_UNSIGNED_INT,
+                                          offsets.data(), GLsizei(counts.size()), baseVertices.data());
+    gl->glBindVertexArray(0);
+    return stats;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <QOpenGLFunctions_3_3_Core>
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <vector>
+#include "scenedata.h"
+#include "meshlets.h"
+
+// Meshlet tabanlı çizim + VRAM bütçesine göre akış (streaming).
+// GPU'da sabit boyutlu slot havuzu vardır; her slot tek bir meshlet'in
+// vertex'lerini (pos + uv + normal + ao) ve yerel index'lerini tutar.
+// Görünür ama yüklü olmayan meshlet'ler boş/en eski slota yüklenir,
+// böylece VRAM'den büyük modeller de gezilebilir.
+class MeshletRenderer
+{
+public:
+    struct FrameStats {
+        int visible = 0;
+        int drawn = 0;
+        int uploaded = 0;
+        int pending = 0;      // kare başı yükleme sınırı nedeniyle sonraki kareye kalan
+        int overBudget = 0;   // boş slot yok: görünür küme VRAM bütçesinden büyük
+    };
+
+    void initialize(QOpenGLFunctions_3_3_Core *functions);
+    void release();
+
+    // scene CPU'da tutulur (streaming kaynağı)
+    void setScene(PackedScene &&scene, MeshletData &&meshlets, size_t budgetBytes);
+    void clear();
+    bool isActive() const { return !data.isEmpty(); }
+    int  meshletCount() const { return int(data.meshlets.size()); }
+
+    // Ekran karesi başına bir kez (paintGL). Aynı karedeki tüm draw()'lar
+    // (çoklu görünüm) birbirinin slotlarını tahliye etmez.
+    void beginFrame() { ++frameIndex; }
+    FrameStats draw(const QMatrix4x4 &mvp, const QVector3D &cameraPos, bool coneCulling);
+
+    static size_t budgetFromEnvironment();
+
+private:
+    static constexpr int    kFloatsPerVertex = PackedScene::kFloatsPerVertex + 1;   // + ao
+    static constexpr int    kMaxUploadsPerFrame = 4096;
+    static constexpr uint32_t kNotResident = UINT32_MAX;
+
+    void uploadMeshlet(uint32_t meshlet, uint32_t slot);
+    uint32_t acquireSlot(uint32_t frame);
+
+    QOpenGLFunctions_3_3_Core *gl = nullptr;
+    GLuint vao = 0, vbo = 0, ebo = 0;
+
+    PackedScene scene;
+    MeshletData data;
+
+    size_t                slotCount = 0;
+    std::vector<uint32_t> slotOf;         // meshlet -> slot
+    std::vector<uint32_t> meshletInSlot;  // slot -> meshlet
+    std::vector<uint32_t> lastUsed;       // slot -> son kullanıldığı kare
+    std::vector<uint32_t> freeSlots;
+    uint32_t              frameIndex = 0;
+    uint32_t              clockHand = 0;
+    bool                  budgetReported = false;   // bütçe aşımı sahne başına bir kez yazılır
+
+    std::vector<uint32_t> visible;
+    std::vector<GLsizei>  counts;
+    std::vector<void*>    offsets;
+    std::vector<GLint>    baseVertices;
+    std::vector<float>    staging;
+};
@@ -0,0 +1,204 @@
+#include "meshlets.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// BVH yapraklarını soldan sağa (derinlik öncelikli) gezerek üçgen sırası
+std::vector<uint32_t> spatialTriangleOrder(const TriangleBVH &bvh, size_t triangleCount)
+{
+    std::vector<uint32_t> order;
+    order.reserve(triangleCount);
+    if (bvh.isEmpty()) {
+        for (size_t t = 0; t < triangleCount; ++t) order.push_back(uint32_t(t));
+        return order;
+    }
+
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const TriangleBVH::Node &n = bvh.nodes[stack.back()];
+        stack.pop_back();
+        if (n.count == 0) {
+            stack.push_back(n.leftFirst + 1);
+            stack.push_back(n.leftFirst);
+            continue;
+        }
+        const uint32_t packEnd = n.leftFirst + (n.count + 3) / 4;
+        for (uint32_t pi = n.leftFirst; pi < packEnd; ++pi)
+            for (uint32_t id : bvh.packs[pi].id)
+                if (id != UINT32_MAX) order.push_back(id);
+    }
+    return order;
+}
+
+void computeBounds(const PackedScene &scene, const MeshletData &data, Meshlet &m)
+{
+    const float *verts = scene.verts.data();
+    const int stride = PackedScene::kFloatsPerVertex;
+
+    // Sphere: AABB merkezi + en uzak vertex
+    float mn[3] = { FLT_MAX,  FLT_MAX,  FLT_MAX};
+    float mx[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (uint32_t i = 0; i < m.vertexCount; ++i) {
+        const float *p = verts + size_t(data.vertices[m.vertexOffset + i]) * stride;
+        for (int a = 0; a < 3; ++a) {
+            mn[a] = std::min(mn[a], p[a]);
+            mx[a] = std::max(mx[a], p[a]);
+        }
+    }
+    float r2 = 0.0f;
+    for (int a = 0; a < 3; ++a) m.center[a] = (mn[a] + mx[a]) * 0.5f;
+    for (uint32_t i = 0; i < m.vertexCount; ++i) {
+        const float *p = verts + size_t(data.vertices[m.vertexOffset + i]) * stride;
+        const float dx = p[0] - m.center[0], dy = p[1] - m.center[1], dz = p[2] - m.center[2];
+        r2 = std::max(r2, dx * dx + dy * dy + dz * dz);
+    }
+    m.radius = std::sqrt(r2);
+
+    // Normal konisi: alan ağırlıklı ortalama eksen, en kötü sapma
+    std::vector<float> normals(size_t(m.triangleCount) * 3);
+    float axis[3] = {0, 0, 0};
+    for (uint32_t t = 0; t < m.triangleCount; ++t) {
+        const uint32_t *tri = data.indices.data() + size_t(m.triangleOffset + t) * 3;
+        const float *a = verts + size_t(data.vertices[m.vertexOffset + tri[0]]) * stride;
+        const float *b = verts + size_t(data.vertices[m.vertexOffset + tri[1]]) * stride;
+        const float *c = verts + size_t(data.vertices[m.vertexOffset + tri[2]]) * stride;
+        const float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        float *n = &normals[size_t(t) * 3];
+        n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+        n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+        n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+        for (int k = 0; k < 3; ++k) axis[k] += n[k];
+        const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (len > 0.0f) { n[0] /= len; n[1] /= len; n[2] /= len; }
+    }
+
+    const float axisLen = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    m.coneCutoff = 2.0f;   // varsayılan: koni testi yok
+    if (axisLen <= 0.0f) return;
+    for (int k = 0; k < 3; ++k) m.coneAxis[k] = axis[k] / axisLen;
+
+    float minDot = 1.0f;
+    for (uint32_t t = 0; t < m.triangleCount; ++t) {
+        const float *n = &normals[size_t(t) * 3];
+        minDot = std::min(minDot, n[0] * m.coneAxis[0] + n[1] * m.coneAxis[1] + n[2] * m.coneAxis[2]);
+    }
+    // Koni yarım küreden genişse arka yüz testi anlamsız
+    if (minDot > 0.0f)
+        m.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+} // namespace
+
+MeshletData Meshlets::build(const PackedScene &scene, const TriangleBVH &bvh)
+{
+    MeshletData data;
+    const size_t triangleCount = scene.idx.size() / 3;
+    if (triangleCount == 0) return data;
+
+    const std::vector<uint32_t> order = spatialTriangleOrder(bvh, triangleCount);
+
+    // Vertex -> yerel index; stamp ile her meshlet'te sıfırlamaya gerek yok
+    std::vector<uint32_t> localIndex(size_t(scene.vertexCount()), 0);
+    std::vector<uint32_t> stamp(size_t(scene.vertexCount()), UINT32_MAX);
+
+    data.indices.reserve(triangleCount * 3);
+    data.vertices.reserve(size_t(scene.vertexCount()) + triangleCount / 2);
+
+    Meshlet current = {};
+    auto flush = [&]() {
+        if (current.triangleCount == 0) return;
+        data.meshlets.push_back(current);
+        current = {};
+        current.vertexOffset = uint32_t(data.vertices.size());
+        current.triangleOffset = uint32_t(data.indices.size() / 3);
+    };
+
+    for (uint32_t t : order) {
+        const unsigned *tri = scene.idx.data() + size_t(t) * 3;
+        const uint32_t id = uint32_t(data.meshlets.size());
+
+        uint32_t newVertices = 0;
+        for (int k = 0; k < 3; ++k)
+            if (stamp[tri[k]] != id) ++newVertices;
+
+        if (current.vertexCount + newVertices > kMaxVertices || current.triangleCount + 1 > kMaxTriangles)
+            flush();
+
+        const uint32_t meshletId = uint32_t(data.meshlets.size());
+        for (int k = 0; k < 3; ++k) {
+            const unsigned v = tri[k];
+            if (stamp[v] != meshletId) {
+                stamp[v] = meshletId;
+                localIndex[v] = current.vertexCount++;
+                data.vertices.push_back(v);
+            }
+            data.indices.push_back(localIndex[v]);
+        }
+        current.triangleCount++;
+    }
+    flush();
+
+    parallelFor(data.meshlets.size(), 256, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            computeBounds(scene, data, data.meshlets[i]);
+    });
+    return data;
+}
+
+void Meshlets::cull(const MeshletData &data, const QMatrix4x4 &mvp, const QVector3D &cameraPos,
+                    bool coneCulling, std::vector<uint32_t> &visible)
+{
+    visible.clear();
+
+    // Frustum düzlemleri doğrudan mvp'den (model uzayında): sol, sağ, alt, üst, yakın, uzak
+    float planes[6][4];
+    for (int i = 0; i < 4; ++i) {
+        const float r3 = mvp(3, i);
+        planes[0][i] = r3 + mvp(0, i);
+        planes[1][i] = r3 - mvp(0, i);
+        planes[2][i] = r3 + mvp(1, i);
+        planes[3][i] = r3 - mvp(1, i);
+        planes[4][i] = r3 + mvp(2, i);
+        planes[5][i] = r3 - mvp(2, i);
+    }
+    for (float *p : planes) {
+        const float len = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (len > 0.0f) for (int i = 0; i < 4; ++i) p[i] /= len;
+    }
+
+    const float cam[3] = {cameraPos.x(), cameraPos.y(), cameraPos.z()};
+    const size_t count = data.meshlets.size();
+
+    // Büyük listelerde paralel, sonra sırayı koruyarak birleştir
+    const size_t grain = 4096;
+    std::vector<std::vector<uint32_t>> parts((count + grain - 1) / grain);
+    parallelFor(count, grain, [&](size_t begin, size_t end) {
+        std::vector<uint32_t> &out = parts[begin / grain];
+        for (size_t i = begin; i < end; ++i) {
+            const Meshlet &m = data.meshlets[i];
+
+            bool inside = true;
+            for (const float *p : planes) {
+                if (p[0] * m.center[0] + p[1] * m.center[1] + p[2] * m.center[2] + p[3] < -m.radius) {
+                    inside = false;
+                    break;
+                }
+            }
+            if (!inside) continue;
+
+            if (coneCulling && m.coneCutoff <= 1.0f) {
+                // Kümedeki tüm üçgenler kameraya arkasını dönüyorsa ele
+                const float d[3] = {m.center[0] - cam[0], m.center[1] - cam[1], m.center[2] - cam[2]};
+                const float dist = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+                const float along = d[0] * m.coneAxis[0] + d[1] * m.coneAxis[1] + d[2] * m.coneAxis[2];
+                if (along >= m.coneCutoff * dist + m.radius * (1.0f + m.coneCutoff)) continue;
+            }
+            out.push_back(uint32_t(i));
+        }
+    });
+    for (const std::vector<uint32_t> &part : parts)
+        visible.insert(visible.end(), part.begin(), part.end());
+}
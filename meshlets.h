@@ -0,0 +1,45 @@
+#pragma once
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <cstdint>
+#include <vector>
+#include "scenedata.h"
+#include "bvh.h"
+
+// Büyük taramalar için meshlet (küçük üçgen kümesi) verisi.
+// Her meshlet en fazla kMaxVertices vertex / kMaxTriangles üçgen içerir,
+// bounding sphere ve normal konisi ile her karede CPU'da elenebilir.
+struct Meshlet
+{
+    float    center[3];
+    float    radius;
+    float    coneAxis[3];
+    float    coneCutoff;       // sin(koni açısı); > 1 ise koni testi yapılmaz
+    uint32_t vertexOffset;     // MeshletData::vertices içinde
+    uint32_t vertexCount;
+    uint32_t triangleOffset;   // MeshletData::indices içinde (üçgen cinsinden)
+    uint32_t triangleCount;
+};
+
+struct MeshletData
+{
+    std::vector<Meshlet>  meshlets;
+    std::vector<uint32_t> vertices;   // meshlet yerel vertex -> PackedScene vertex
+    std::vector<uint32_t> indices;    // meshlet yerel index'ler (0..kMaxVertices-1), 3'er 3'er
+
+    bool isEmpty() const { return meshlets.empty(); }
+};
+
+namespace Meshlets
+{
+    constexpr uint32_t kMaxVertices  = 64;
+    constexpr uint32_t kMaxTriangles = 124;
+
+    // Üçgenler BVH yaprak sırasıyla gezilir - uzamsal olarak tutarlı kümeler çıkar
+    MeshletData build(const PackedScene &scene, const TriangleBVH &bvh);
+
+    // Görünür meshlet'lerin sıkıştırılmış listesi. mvp model uzayından clip uzayına,
+    // cameraPos model uzayında. coneCulling kapalıysa sadece frustum testi yapılır.
+    void cull(const MeshletData &data, const QMatrix4x4 &mvp, const QVector3D &cameraPos,
+              bool coneCulling, std::vector<uint32_t> &visible);
+}
@@ -0,0 +1,143 @@
+#include "mmapiosystem.h"
+#include <QFileInfo>
+#include <QDir>
+#include <assimp/Importer.hpp>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#endif
+
+MappedIOStream::MappedIOStream(QFile *file, const uchar *data, size_t size)
+    : file(file), data(data), size(size)
+{
+#ifdef Q_OS_UNIX
+    // Baştan sona okunacak: agresif read-ahead iste, sayfaları şimdiden getirt
+    if (data && size > 0) {
+        void *addr = const_cast<uchar*>(data);
+        madvise(addr, size, MADV_SEQUENTIAL);
+        madvise(addr, size, MADV_WILLNEED);
+    }
+#endif
+}
+
+MappedIOStream::~MappedIOStream()
+{
+    if (data) file->unmap(const_cast<uchar*>(data));
+    delete file;
+}
+
+size_t MappedIOStream::Read(void *buffer, size_t elemSize, size_t count)
+{
+    if (elemSize == 0 || count == 0 || position >= size) return 0;
+
+    // Sadece tam elemanlar (fread gibi)
+    const size_t elements = qMin(count, (size - position) / elemSize);
+    const size_t bytes = elements * elemSize;
+    if (data) {
+        memcpy(buffer, data + position, bytes);
+    } else {
+        // Eşleme yok: QFile'ın kendi tamponundan oku
+        if (!file->seek(qint64(position))) return 0;
+        const qint64 read = file->read(static_cast<char*>(buffer), qint64(bytes));
+        if (read <= 0) return 0;
+        position += size_t(read);
+        return size_t(read) / elemSize;
+    }
+    position += bytes;
+    return elements;
+}
+
+size_t MappedIOStream::Write(const void *, size_t, size_t)
+{
+    return 0;   // salt okunur
+}
+
+aiReturn MappedIOStream::Seek(size_t offset, aiOrigin origin)
+{
+    size_t target = 0;
+    switch (origin) {
+    case aiOrigin_SET: target = offset; break;
+    case aiOrigin_CUR: target = position + offset; break;
+    case aiOrigin_END: target = size + offset; break;   // fseek sırası: negatif offset sarılı gelir
+    default: return AI_FAILURE;
+    }
+    if (target > size) return AI_FAILURE;
+    position = target;
+    return AI_SUCCESS;
+}
+
+size_t MappedIOStream::Tell() const
+{
+    return position;
+}
+
+size_t MappedIOStream::FileSize() const
+{
+    return size;
+}
+
+void MappedIOStream::Flush()
+{
+}
+
+QString MappedIOSystem::resolve(const char *file) const
+{
+    const QString path = QString::fromUtf8(file);
+    if (QFileInfo::exists(path) || modelDirectory.isEmpty()) return path;
+
+    // loadTexture ile aynı: model dizini + "/" + referans
+    const QString relative = modelDirectory + "/" + path;
+    if (QFileInfo::exists(relative)) return relative;
+
+    // Mutlak/başka makineden kalma yollar: sadece dosya adı
+    const QString byName = modelDirectory + "/" + QFileInfo(path).fileName();
+    if (QFileInfo::exists(byName)) return byName;
+    return path;
+}
+
+bool MappedIOSystem::Exists(const char *file) const
+{
+    return QFileInfo(resolve(file)).isFile();
+}
+
+char MappedIOSystem::getOsSeparator() const
+{
+    return QDir::separator().toLatin1();
+}
+
+Assimp::IOStream *MappedIOSystem::Open(const char *file, const char *mode)
+{
+    // Exporter'lar hariç Assimp sadece okur; yazma istenirse destekleme
+    if (mode && (strchr(mode, 'w') || strchr(mode, 'a') || strchr(mode, '+'))) return nullptr;
+
+    QFile *qfile = new QFile(resolve(file));
+    if (!qfile->open(QIODevice::ReadOnly)) {
+        delete qfile;
+        return nullptr;
+    }
+
+    const size_t size = size_t(qfile->size());
+    const uchar *data = size > 0 ? qfile->map(0, qint64(size)) : nullptr;
+    if (size > 0 && !data) {
+        // Ağ paylaşımı vb.: eşlenemiyorsa stdio gibi tamponlu okuma
+        printf("mmap başarısız, tamponlu okuma: %s\n", qfile->fileName().toStdString().c_str());
+    }
+    return new MappedIOStream(qfile, data, size);
+}
+
+void MappedIOSystem::Close(Assimp::IOStream *stream)
+{
+    delete stream;
+}
+
+MappedIOSystem *MappedIOSystem::install(Assimp::Importer &importer, const QString &modelPath)
+{
+    MappedIOSystem *io = dynamic_cast<MappedIOSystem*>(importer.GetIOHandler());
+    if (!io) {
+        io = new MappedIOSystem;
+        importer.SetIOHandler(io);   // importer sahiplenir
+    }
+    io->setModelDirectory(QFileInfo(modelPath).absolutePath());
+    return io;
+}
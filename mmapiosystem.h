@@ -0,0 +1,51 @@
+#pragma once
+#include <QString>
+#include <QFile>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+
+namespace Assimp { class Importer; }
+
+// Assimp okumalarını dosyanın bellek eşlemesinden (mmap) karşılayan stream.
+// stdio tamponu ve ara kopyalar yok; sayfa önbelleğindeki dosya doğrudan okunur.
+// data null ise (mmap başarısız: ağ dosya sistemleri) tamponlu QFile okumasına düşer.
+class MappedIOStream : public Assimp::IOStream
+{
+public:
+    MappedIOStream(QFile *file, const uchar *data, size_t size);
+    ~MappedIOStream() override;
+
+    size_t Read(void *buffer, size_t size, size_t count) override;
+    size_t Write(const void *buffer, size_t size, size_t count) override;
+    aiReturn Seek(size_t offset, aiOrigin origin) override;
+    size_t Tell() const override;
+    size_t FileSize() const override;
+    void Flush() override;
+
+private:
+    QFile       *file;
+    const uchar *data;
+    size_t       size;
+    size_t       position = 0;
+};
+
+// GLViewport::importer'a takılan IOSystem. Model dışındaki dosyalar
+// (texture, .mtl, .bin) bulunamazsa loadTexture gibi model dizinine göre aranır.
+class MappedIOSystem : public Assimp::IOSystem
+{
+public:
+    void setModelDirectory(const QString &dir) { modelDirectory = dir; }
+
+    bool Exists(const char *file) const override;
+    char getOsSeparator() const override;
+    Assimp::IOStream *Open(const char *file, const char *mode = "rb") override;
+    void Close(Assimp::IOStream *stream) override;
+
+    // importer'da yoksa takar, model dizinini ayarlar
+    static MappedIOSystem *install(Assimp::Importer &importer, const QString &modelPath);
+
+private:
+    QString resolve(const char *file) const;
+
+    QString modelDirectory;
+};
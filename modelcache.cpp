@@ -0,0 +1,39 @@
+#include "modelcache.h"
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QFile>
+#include <QDir>
+
+QString ModelCache::filePath(const QString &modelPath, const QString &kind)
+{
+    const QFileInfo info(modelPath);
+    const QString key = info.absoluteFilePath() + '|' + QString::number(info.size()) + '|' +
+                        QString::number(info.lastModified().toMSecsSinceEpoch());
+    const QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/models";
+    return dir + "/" + QString::fromLatin1(hash) + "." + kind;
+}
+
+bool ModelCache::load(const QString &modelPath, const QString &kind, QByteArray &data)
+{
+    QFile file(filePath(modelPath, kind));
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    data = file.readAll();
+    return !data.isEmpty();
+}
+
+bool ModelCache::save(const QString &modelPath, const QString &kind, const QByteArray &data)
+{
+    const QString path = filePath(modelPath, kind);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    // Yarım yazılmış cache okunmasın diye atomik yaz
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    file.write(data);
+    return file.commit();
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <QString>
+#include <QByteArray>
+
+// Modelden türetilen (pahalı) verilerin disk cache'i: AO, BVH vb.
+// Anahtar; dosya yolu + boyut + değiştirilme zamanı. Model değişince
+// eski kayıt kendiliğinden geçersiz olur.
+namespace ModelCache
+{
+    QString filePath(const QString &modelPath, const QString &kind);
+    bool load(const QString &modelPath, const QString &kind, QByteArray &data);
+    bool save(const QString &modelPath, const QString &kind, const QByteArray &data);
+}
@@ -0,0 +1,536 @@
+#include "modelindex.h"
+#include "mmapiosystem.h"
+#include "parallel.h"
+#include <QBuffer>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QImageReader>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+#include <QUrl>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+constexpr quint32 kIndexMagic   = 0x31584449;   // "IDX1"
+constexpr quint32 kIndexVersion = 1;
+constexpr qint64  kImageProbeBytes = 256 * 1024;   // JPEG başlığı EXIF'ten sonra gelebilir
+
+constexpr quint32 kGlbMagic = 0x46546C67;   // "glTF"
+constexpr quint32 kGlbJson  = 0x4E4F534A;   // "JSON"
+constexpr quint32 kGlbBin   = 0x004E4942;   // "BIN\0"
+
+// Sadece başlık okunur (PNG IHDR / JPEG SOF) - piksel çözülmez
+QSize imageSize(const QByteArray &head)
+{
+    QByteArray copy = head;
+    QBuffer buffer(&copy);
+    buffer.open(QIODevice::ReadOnly);
+    return QImageReader(&buffer).size();
+}
+
+void noteTexture(ModelInfo &info, const QSize &size)
+{
+    if (!size.isValid()) return;
+    if (quint64(size.width()) * size.height() > quint64(info.textureWidth) * info.textureHeight) {
+        info.textureWidth = quint32(size.width());
+        info.textureHeight = quint32(size.height());
+    }
+}
+
+// Bozuk dosyada sınır dışı indeks olabilir - operator[] assert'e düşmesin
+QJsonObject element(const QJsonArray &array, int index)
+{
+    return index >= 0 && index < array.size() ? array[index].toObject() : QJsonObject();
+}
+
+quint64 trianglesFor(int mode, quint64 count)
+{
+    switch (mode) {
+    case 4:  return count / 3;                       // TRIANGLES
+    case 5:                                          // TRIANGLE_STRIP
+    case 6:  return count >= 3 ? count - 2 : 0;      // TRIANGLE_FAN
+    default: return 0;                               // nokta / çizgi
+    }
+}
+
+// GLB: 12 bayt başlık + JSON chunk okunur; BIN chunk'ına sadece texture başlıkları için bakılır
+bool extractGlb(const QString &path, ModelInfo &info)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    quint32 header[5];   // magic, version, length, chunk0 length, chunk0 type
+    if (file.read(reinterpret_cast<char*>(header), sizeof(header)) != qint64(sizeof(header))) return false;
+    if (header[0] != kGlbMagic || header[1] != 2 || header[4] != kGlbJson) return false;
+
+    const QByteArray json = file.read(header[3]);
+    if (json.size() != qsizetype(header[3])) return false;
+
+    qint64 binOffset = -1;
+    quint32 binHeader[2];
+    if (file.read(reinterpret_cast<char*>(binHeader), sizeof(binHeader)) == qint64(sizeof(binHeader)) &&
+        binHeader[1] == kGlbBin)
+        binOffset = file.pos();
+
+    const QJsonObject gltf = QJsonDocument::fromJson(json).object();
+    if (gltf.isEmpty()) return false;
+
+    const QJsonArray accessors   = gltf["accessors"].toArray();
+    const QJsonArray meshes      = gltf["meshes"].toArray();
+    const QJsonArray nodes       = gltf["nodes"].toArray();
+    const QJsonArray bufferViews = gltf["bufferViews"].toArray();
+    const QJsonArray images      = gltf["images"].toArray();
+
+    // Düğüm ağacındaki mesh kullanımları - instance'lar ayrı sayılır (import ile aynı)
+    std::vector<quint32> uses(size_t(meshes.size()), 0);
+    std::vector<int> stack;
+    const QJsonArray scenes = gltf["scenes"].toArray();
+    if (!scenes.isEmpty()) {
+        for (const QJsonValue root : element(scenes, gltf["scene"].toInt(0))["nodes"].toArray())
+            stack.push_back(root.toInt());
+    }
+    for (size_t visits = 0; !stack.empty() && visits < 1000000; ++visits) {
+        const int n = stack.back();
+        stack.pop_back();
+        const QJsonObject node = element(nodes, n);
+        const int mesh = node["mesh"].toInt(-1);
+        if (mesh >= 0 && mesh < meshes.size()) ++uses[size_t(mesh)];
+        for (const QJsonValue child : node["children"].toArray())
+            stack.push_back(child.toInt());
+    }
+    if (std::all_of(uses.begin(), uses.end(), [](quint32 u) { return u == 0; }))
+        std::fill(uses.begin(), uses.end(), 1u);
+
+    for (qsizetype m = 0; m < meshes.size(); ++m) {
+        for (const QJsonValue primitive : meshes[m].toObject()["primitives"].toArray()) {
+            const QJsonObject p = primitive.toObject();
+            const quint64 vertexCount = quint64(element(accessors, p["attributes"].toObject()["POSITION"].toInt(-1))["count"].toDouble());
+            const quint64 indexCount = p.contains("indices")
+                ? quint64(element(accessors, p["indices"].toInt(-1))["count"].toDouble())
+                : vertexCount;
+            info.triangles += trianglesFor(p["mode"].toInt(4), indexCount) * uses[size_t(m)];
+            info.vertices += vertexCount * uses[size_t(m)];
+            ++info.meshes;   // Assimp her primitive'i ayrı aiMesh yapar
+        }
+    }
+    info.materials = quint32(gltf["materials"].toArray().size());
+    info.textures = quint32(images.size());
+
+    for (const QJsonValue value : images) {
+        const QJsonObject image = value.toObject();
+        if (image.contains("bufferView") && binOffset >= 0) {
+            const QJsonObject view = element(bufferViews, image["bufferView"].toInt(-1));
+            if (!file.seek(binOffset + qint64(view["byteOffset"].toDouble()))) continue;
+            noteTexture(info, imageSize(file.read(qMin(qint64(view["byteLength"].toDouble()), kImageProbeBytes))));
+        } else if (image.contains("uri")) {
+            const QString uri = image["uri"].toString();
+            if (uri.startsWith("data:")) {
+                const qsizetype comma = uri.indexOf(',');
+                const QByteArray encoded = uri.mid(comma + 1, kImageProbeBytes / 3 * 4).toLatin1();
+                noteTexture(info, imageSize(QByteArray::fromBase64(encoded)));
+            } else {
+                const QString external = QFileInfo(path).absolutePath() + "/" + QUrl::fromPercentEncoding(uri.toUtf8());
+                noteTexture(info, QImageReader(external).size());
+            }
+        }
+    }
+    return true;
+}
+
+// OBJ'de başlık yok: tek geçişlik satır taraması (sayılar parse edilmez)
+bool extractObj(const QString &path, ModelInfo &info)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    const qint64 size = file.size();
+    const char *data = size > 0 ? reinterpret_cast<const char*>(file.map(0, size)) : nullptr;
+    if (!data) return false;
+
+    QSet<QByteArray> materials;
+    QByteArray mtllib;
+    const char *p = data;
+    const char *end = data + size;
+    while (p < end) {
+        const char *eol = static_cast<const char*>(memchr(p, '\n', size_t(end - p)));
+        if (!eol) eol = end;
+        while (p < eol && (*p == ' ' || *p == '\t')) ++p;
+
+        const qint64 length = eol - p;
+        if (length > 2 && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t')) {
+            ++info.vertices;
+        } else if (length > 2 && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+            // Köşe sayısı = boşlukla ayrılmış token sayısı; n-gon -> n-2 üçgen
+            int corners = 0;
+            bool inToken = false;
+            for (const char *c = p + 1; c < eol; ++c) {
+                const bool space = *c == ' ' || *c == '\t' || *c == '\r';
+                if (!space && !inToken) ++corners;
+                inToken = !space;
+            }
+            if (corners >= 3) info.triangles += quint64(corners - 2);
+        } else if (length > 7 && memcmp(p, "usemtl", 6) == 0) {
+            materials.insert(QByteArray(p + 7, int(length - 7)).trimmed());
+        } else if (length > 7 && memcmp(p, "mtllib", 6) == 0) {
+            mtllib = QByteArray(p + 7, int(length - 7)).trimmed();
+        }
+        p = eol + 1;
+    }
+    file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(data)));
+
+    info.materials = quint32(materials.size());
+    info.meshes = quint32(qMax(1, int(materials.size())));   // Assimp materyale göre böler
+
+    // Diffuse texture'lar .mtl'den, boyut görüntü başlığından
+    const QString dir = QFileInfo(path).absolutePath();
+    QFile mtl(dir + "/" + QString::fromUtf8(mtllib));
+    if (!mtllib.isEmpty() && mtl.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!mtl.atEnd()) {
+            const QByteArray line = mtl.readLine().trimmed();
+            if (!line.startsWith("map_Kd")) continue;
+            ++info.textures;
+            const QByteArray texture = line.mid(6).trimmed().split(' ').last();
+            noteTexture(info, QImageReader(dir + "/" + QString::fromUtf8(texture)).size());
+        }
+    }
+    return true;
+}
+
+// Diğer formatlar: post-process'siz Assimp (en pahalı yol, sonuç indekste kalır)
+bool extractWithAssimp(const QString &path, ModelInfo &info)
+{
+    Assimp::Importer importer;
+    MappedIOSystem::install(importer, path);
+    const aiScene *scene = importer.ReadFile(path.toStdString(), 0);
+    if (!scene) return false;
+
+    for (unsigned m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh *mesh = scene->mMeshes[m];
+        info.vertices += mesh->mNumVertices;
+        for (unsigned f = 0; f < mesh->mNumFaces; ++f)
+            if (mesh->mFaces[f].mNumIndices >= 3) info.triangles += mesh->mFaces[f].mNumIndices - 2;
+    }
+    info.meshes = scene->mNumMeshes;
+    info.materials = scene->mNumMaterials;
+    info.textures = scene->mNumTextures;
+    for (unsigned t = 0; t < scene->mNumTextures; ++t) {
+        const aiTexture *tex = scene->mTextures[t];
+        if (tex->mHeight == 0)
+            noteTexture(info, imageSize(QByteArray(reinterpret_cast<const char*>(tex->pcData), int(tex->mWidth))));
+        else
+            noteTexture(info, QSize(int(tex->mWidth), int(tex->mHeight)));
+    }
+    return true;
+}
+
+} // namespace
+
+ModelIndex::ModelIndex(QObject *parent)
+    : QObject(parent)
+{
+    load();
+}
+
+ModelIndex::~ModelIndex()
+{
+    if (worker) {
+        worker->wait();
+        delete worker;
+    }
+}
+
+QString ModelIndex::storagePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/modelindex.bin";
+}
+
+bool ModelIndex::extract(const QString &path, ModelInfo &info)
+{
+    const QString suffix = QFileInfo(path).suffix().toLower();
+    if (suffix == "glb") return extractGlb(path, info);
+    if (suffix == "obj") return extractObj(path, info);
+    return extractWithAssimp(path, info);
+}
+
+const ModelInfo *ModelIndex::find(const QFileInfo &file) const
+{
+    auto it = entries.constFind(file.absoluteFilePath());
+    if (it == entries.constEnd()) return nullptr;
+    if (it->size != file.size() || it->mtime != file.lastModified().toMSecsSinceEpoch()) return nullptr;
+    return &it.value();
+}
+
+void ModelIndex::refresh(const QFileInfoList &files)
+{
+    if (worker) {
+        // Çalışan tarama bitince son liste ile bir kez daha
+        pendingFiles = files;
+        pending = true;
+        return;
+    }
+
+    QStringList todo;
+    for (const QFileInfo &file : files)
+        if (!find(file)) todo.append(file.absoluteFilePath());
+    if (todo.isEmpty()) {
+        if (prune()) save();
+        return;
+    }
+
+    printf("Model indeksi: %lld dosya taranacak\n", (long long)todo.size());
+    fflush(stdout);
+
+    auto results = std::make_shared<std::vector<ModelInfo>>(size_t(todo.size()));
+    worker = QThread::create([todo, results]() {
+        parallelFor(size_t(todo.size()), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                ModelInfo &info = (*results)[i];
+                const QFileInfo file(todo[qsizetype(i)]);
+                info.path = file.absoluteFilePath();
+                info.size = file.size();
+                info.mtime = file.lastModified().toMSecsSinceEpoch();
+                info.indexed = ModelIndex::extract(info.path, info);
+            }
+        });
+    });
+    connect(worker, &QThread::finished, this, [this, results]() {
+        worker->deleteLater();
+        worker = nullptr;
+
+        // Başarısız olanlar da saklanır - dosya değişmedikçe tekrar denenmez
+        for (ModelInfo &info : *results)
+            entries.insert(info.path, std::move(info));
+        prune();
+        save();
+        emit updated();
+
+        if (pending) {
+            pending = false;
+            refresh(pendingFiles);
+        }
+    });
+    worker->start();
+}
+
+int ModelIndex::prune()
+{
+    // Silinen/taşınan dosyaların kayıtları indekste birikmesin
+    int removed = 0;
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (QFileInfo::exists(it.key())) {
+            ++it;
+        } else {
+            it = entries.erase(it);
+            ++removed;
+        }
+    }
+    if (removed) printf("Model indeksi: %d eski kayıt silindi\n", removed);
+    return removed;
+}
+
+bool ModelIndex::load()
+{
+    QFile file(storagePath());
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version >> count;
+    if (magic != kIndexMagic || version != kIndexVersion) return false;
+
+    entries.reserve(qsizetype(count));
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        ModelInfo info;
+        in >> info.path >> info.size >> info.mtime >> info.indexed
+           >> info.triangles >> info.vertices >> info.meshes >> info.materials
+           >> info.textures >> info.textureWidth >> info.textureHeight;
+        entries.insert(info.path, info);
+    }
+    printf("Model indeksi: %lld kayıt\n", (long long)entries.size());
+    return in.status() == QDataStream::Ok;
+}
+
+bool ModelIndex::save() const
+{
+    const QString path = storagePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    // Yarım yazılmış indeks okunmasın diye atomik yaz
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kIndexMagic << kIndexVersion << quint32(entries.size());
+    for (const ModelInfo &info : entries) {
+        out << info.path << info.size << info.mtime << info.indexed
+            << info.triangles << info.vertices << info.meshes << info.materials
+            << info.textures << info.textureWidth << info.textureHeight;
+    }
+    return file.commit();
+}
+
+/* ---------- filtre / sıralama --------------------------------------------------- */
+namespace {
+
+bool fieldFor(const QString &name, ModelQuery::Condition::Field &field)
+{
+    using C = ModelQuery::Condition;
+    static const QHash<QString, C::Field> fields = {
+        {"name", C::Name}, {"isim", C::Name},
+        {"triangles", C::Triangles}, {"tris", C::Triangles}, {"tri", C::Triangles},
+        {"vertices", C::Vertices}, {"verts", C::Vertices},
+        {"meshes", C::Meshes}, {"mesh", C::Meshes},
+        {"materials", C::Materials}, {"mats", C::Materials},
+        {"textures", C::Textures},
+        {"tex", C::TextureSize}, {"texture", C::TextureSize},
+        {"size", C::Size}, {"boyut", C::Size},
+    };
+    auto it = fields.constFind(name.toLower());
+    if (it == fields.constEnd()) return false;
+    field = it.value();
+    return true;
+}
+
+bool numberFor(const QString &text, bool bytes, double &value)
+{
+    static const QRegularExpression number(R"(^(\d+(?:\.\d+)?)(k|m|g|kb|mb|gb)?$)",
+                                           QRegularExpression::CaseInsensitiveOption);
+    const QRegularExpressionMatch m = number.match(text);
+    if (!m.hasMatch()) return false;
+
+    const QString unit = m.captured(2).toLower();
+    const double base = bytes ? 1024.0 : 1000.0;   // boyut ikilik, sayılar onluk
+    double scale = 1.0;
+    if (unit.startsWith('k')) scale = base;
+    else if (unit.startsWith('m')) scale = base * base;
+    else if (unit.startsWith('g')) scale = base * base * base;
+    value = m.captured(1).toDouble() * scale;
+    return true;
+}
+
+double fieldValue(const ModelInfo &info, ModelQuery::Condition::Field field)
+{
+    using C = ModelQuery::Condition;
+    switch (field) {
+    case C::Triangles:   return double(info.triangles);
+    case C::Vertices:    return double(info.vertices);
+    case C::Meshes:      return info.meshes;
+    case C::Materials:   return info.materials;
+    case C::Textures:    return info.textures;
+    case C::TextureSize: return qMax(info.textureWidth, info.textureHeight);
+    case C::Size:        return double(info.size);
+    case C::Name:        break;
+    }
+    return 0.0;
+}
+
+} // namespace
+
+bool ModelQuery::parse(const QString &query, std::vector<Condition> &out, QString *error)
+{
+    static const QRegularExpression clause(R"((\w+)\s*(>=|<=|!=|>|<|=|~)\s*([^\s,]+))");
+    static const QRegularExpression separators(R"([\s,]+)");
+
+    out.clear();
+    QString rest = query;
+    QRegularExpressionMatchIterator it = clause.globalMatch(query);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch m = it.next();
+        Condition c;
+        if (!fieldFor(m.captured(1), c.field)) {
+            if (error) *error = "Bilinmeyen alan: " + m.captured(1);
+            return false;
+        }
+
+        const QString op = m.captured(2);
+        c.op = op == "<"  ? Condition::Less      : op == "<=" ? Condition::LessEqual :
+               op == ">"  ? Condition::Greater   : op == ">=" ? Condition::GreaterEqual :
+               op == "!=" ? Condition::NotEqual  : op == "~"  ? Condition::Contains : Condition::Equal;
+
+        if (c.field == Condition::Name) {
+            if (c.op != Condition::Equal && c.op != Condition::Contains && c.op != Condition::NotEqual) {
+                if (error) *error = "İsimde sadece =, != ve ~ kullanılabilir";
+                return false;
+            }
+            c.text = m.captured(3).toCaseFolded();
+        } else if (c.op == Condition::Contains || !numberFor(m.captured(3), c.field == Condition::Size, c.value)) {
+            if (error) *error = "Geçersiz sayı: " + m.captured(3);
+            return false;
+        }
+        out.push_back(c);
+        rest.replace(m.captured(0), " ");
+    }
+
+    // Operatörsüz kelimeler: isimde geçsin
+    for (const QString &word : rest.split(separators, Qt::SkipEmptyParts)) {
+        if (word.compare("and", Qt::CaseInsensitive) == 0 || word.compare("ve", Qt::CaseInsensitive) == 0)
+            continue;
+        Condition c;
+        c.text = word.toCaseFolded();
+        out.push_back(c);
+    }
+    return true;
+}
+
+QString ModelQuery::nameKey(const QString &path)
+{
+    return QFileInfo(path).fileName().toCaseFolded();
+}
+
+bool ModelQuery::matches(const ModelInfo &info, const QString &name, const std::vector<Condition> &conditions)
+{
+    for (const Condition &c : conditions) {
+        if (c.field == Condition::Name) {
+            // İkisi de case-folded - büyük/küçük harf duyarsız
+            bool hit = c.op == Condition::Contains ? name.contains(c.text) : name == c.text;
+            if (c.op == Condition::NotEqual) hit = !hit;
+            if (!hit) return false;
+            continue;
+        }
+
+        // Henüz indekslenmemiş model sayısal koşulu sağlamaz (boyut hariç - o hep bilinir)
+        if (!info.indexed && c.field != Condition::Size) return false;
+
+        const double v = fieldValue(info, c.field);
+        bool hit = false;
+        switch (c.op) {
+        case Condition::Less:         hit = v <  c.value; break;
+        case Condition::LessEqual:    hit = v <= c.value; break;
+        case Condition::Greater:      hit = v >  c.value; break;
+        case Condition::GreaterEqual: hit = v >= c.value; break;
+        case Condition::Equal:        hit = v == c.value; break;
+        case Condition::NotEqual:     hit = v != c.value; break;
+        case Condition::Contains:     break;
+        }
+        if (!hit) return false;
+    }
+    return true;
+}
+
+bool ModelQuery::lessThan(const ModelInfo &a, const QString &nameA,
+                          const ModelInfo &b, const QString &nameB, SortKey key)
+{
+    double va = 0.0, vb = 0.0;
+    switch (key) {
+    case ByName:        break;
+    case BySize:        va = double(a.size);      vb = double(b.size); break;
+    case ByTriangles:   va = double(a.triangles); vb = double(b.triangles); break;
+    case ByTextureSize: va = qMax(a.textureWidth, a.textureHeight); vb = qMax(b.textureWidth, b.textureHeight); break;
+    case ByMaterials:   va = a.materials;         vb = b.materials; break;
+    }
+    if (va != vb) return va > vb;
+    return nameA < nameB;
+}
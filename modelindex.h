@@ -0,0 +1,84 @@
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QFileInfo>
+#include <QThread>
+#include <vector>
+
+// Modeli yüklemeden çıkarılan özet bilgi (katalogda sıralama/filtre için)
+struct ModelInfo
+{
+    QString path;                 // mutlak yol (bundle kaydında dosya adı)
+    qint64  size = 0;
+    qint64  mtime = 0;            // ms (epoch)
+    bool    indexed = false;      // metadata çıkarıldı mı
+    quint64 triangles = 0;
+    quint64 vertices = 0;
+    quint32 meshes = 0;
+    quint32 materials = 0;
+    quint32 textures = 0;
+    quint32 textureWidth = 0;     // en büyük texture
+    quint32 textureHeight = 0;
+};
+
+// Diskte kalıcı metadata indeksi. GLB için sadece JSON chunk'ı (ve texture
+// başlıkları), OBJ için satır taraması okunur; diğer formatlar post-process'siz
+// Assimp ile. Kayıtlar boyut + mtime ile eşleşirse yeniden çıkarılmaz.
+class ModelIndex : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ModelIndex(QObject *parent = nullptr);
+    ~ModelIndex() override;
+
+    // Değişmeyenler korunur, yeni/değişenler arka planda çıkarılır; bitince updated()
+    void refresh(const QFileInfoList &files);
+    // Güncel (boyut + mtime tutan) kayıt, yoksa nullptr
+    const ModelInfo *find(const QFileInfo &file) const;
+
+    static bool extract(const QString &path, ModelInfo &info);
+    static QString storagePath();
+
+signals:
+    void updated();
+
+private:
+    bool load();
+    bool save() const;
+    // Diskte artık olmayan yolların kayıtlarını siler, silinen sayısını döner
+    int  prune();
+
+    QHash<QString, ModelInfo> entries;
+    QThread      *worker = nullptr;
+    QFileInfoList pendingFiles;
+    bool          pending = false;
+};
+
+// Katalog filtresi: "triangles > 500k tex >= 2048 shirt" gibi. Operatörsüz
+// kelimeler isimde aranır. Alanlar: triangles/tris, vertices/verts, meshes,
+// materials/mats, textures, tex (en uzun kenar), size (kb/mb/gb), name.
+// Sayılarda k = bin, m = milyon.
+namespace ModelQuery
+{
+    struct Condition
+    {
+        enum Field { Name, Triangles, Vertices, Meshes, Materials, Textures, TextureSize, Size };
+        enum Op { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual, Contains };
+        Field   field = Name;
+        Op      op = Contains;
+        double  value = 0.0;
+        QString text;
+    };
+
+    enum SortKey { ByName, BySize, ByTriangles, ByTextureSize, ByMaterials };
+
+    bool parse(const QString &query, std::vector<Condition> &out, QString *error = nullptr);
+    // İsim anahtarı: case-folded dosya adı. Öğe başına bir kez hesaplanıp
+    // matches/lessThan'e verilir (karşılaştırma başına QFileInfo yok).
+    QString nameKey(const QString &path);
+    bool matches(const ModelInfo &info, const QString &name, const std::vector<Condition> &conditions);
+    // Sayısal anahtarlarda büyükten küçüğe, eşitlikte isme göre
+    bool lessThan(const ModelInfo &a, const QString &nameA,
+                  const ModelInfo &b, const QString &nameB, SortKey key);
+}
@@ -0,0 +1,801 @@
+#include "objloader.h"
+#include "parallel.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QtGlobal>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+constexpr uint32_t kMissing   = UINT32_MAX;
+constexpr int      kShardBits = 6;
+constexpr size_t   kShards    = size_t(1) << kShardBits;
+constexpr size_t   kBlock     = size_t(1) << 16;   // weld/scan blok boyu (köşe)
+
+enum LineType { Other, Position, TexCoord, Normal, Face, Group, Material, MaterialLib };
+
+struct Marker
+{
+    size_t     triangle;   // global üçgen index'i
+    bool       material;   // false: o/g, true: usemtl
+    QByteArray name;
+};
+
+struct Chunk
+{
+    const char *begin = nullptr;
+    const char *end = nullptr;
+
+    // 1. geçiş: sayım
+    size_t positions = 0, texCoords = 0, normals = 0;
+    size_t faces = 0, corners = 0, triangles = 0;
+
+    // prefix sum sonrası global başlangıçlar
+    size_t positionBase = 0, texCoordBase = 0, normalBase = 0;
+    size_t faceBase = 0, cornerBase = 0, triangleBase = 0;
+
+    // 2. geçiş
+    std::vector<Marker> markers;
+    QByteArray materialLib;
+    QByteArray firstMaterial;
+    bool ok = true;
+};
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline const char *skipSpace(const char *p, const char *end)
+{
+    while (p < end && isSpace(*p)) ++p;
+    return p;
+}
+
+inline const char *lineEnd(const char *p, const char *end)
+{
+    const void *nl = memchr(p, '\n', size_t(end - p));
+    return nl ? static_cast<const char*>(nl) : end;
+}
+
+inline bool startsWith(const char *p, const char *end, const char *word, size_t len)
+{
+    return size_t(end - p) > len && memcmp(p, word, len) == 0 && isSpace(p[len]);
+}
+
+LineType classify(const char *&p, const char *eol)
+{
+    p = skipSpace(p, eol);
+    if (eol - p < 2) return Other;
+
+    switch (p[0]) {
+    case 'v':
+        if (isSpace(p[1])) { p += 2; return Position; }
+        if (eol - p > 2 && isSpace(p[2])) {
+            if (p[1] == 't') { p += 3; return TexCoord; }
+            if (p[1] == 'n') { p += 3; return Normal; }
+        }
+        break;
+    case 'f':
+        if (isSpace(p[1])) { p += 2; return Face; }
+        break;
+    case 'o':
+    case 'g':
+        if (isSpace(p[1])) { p += 2; return Group; }
+        break;
+    case 'u':
+        if (startsWith(p, eol, "usemtl", 6)) { p += 7; return Material; }
+        break;
+    case 'm':
+        if (startsWith(p, eol, "mtllib", 6)) { p += 7; return MaterialLib; }
+        break;
+    }
+    return Other;
+}
+
+QByteArray restOfLine(const char *p, const char *eol)
+{
+    p = skipSpace(p, eol);
+    while (eol > p && isSpace(eol[-1])) --eol;
+    return QByteArray(p, int(eol - p));
+}
+
+size_t countTokens(const char *p, const char *eol)
+{
+    size_t n = 0;
+    for (;;) {
+        p = skipSpace(p, eol);
+        if (p >= eol) return n;
+        ++n;
+        while (p < eol && !isSpace(*p)) ++p;
+    }
+}
+
+const double kPow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// strtod'dan çok daha hızlı (locale yok, tek geçiş); OBJ'deki ondalık ve
+// üstel yazımlar için yeterli hassasiyet. Sayı yoksa nullptr.
+const char *parseFloat(const char *p, const char *end, float &out)
+{
+    p = skipSpace(p, end);
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) { negative = *p == '-'; ++p; }
+
+    uint64_t mantissa = 0;
+    int exponent = 0, digits = 0;
+    bool any = false;
+    for (; p < end && unsigned(*p - '0') < 10; ++p) {
+        any = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + uint64_t(*p - '0');
+            if (mantissa) ++digits;
+        } else {
+            ++exponent;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && unsigned(*p - '0') < 10; ++p) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + uint64_t(*p - '0');
+                if (mantissa) ++digits;
+                --exponent;
+            }
+        }
+    }
+    if (!any) return nullptr;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool expNegative = false;
+        if (p < end && (*p == '-' || *p == '+')) { expNegative = *p == '-'; ++p; }
+        int e = 0;
+        bool expAny = false;
+        for (; p < end && unsigned(*p - '0') < 10; ++p) {
+            expAny = true;
+            if (e < 10000) e = e * 10 + (*p - '0');
+        }
+        if (!expAny) return nullptr;
+        exponent += expNegative ? -e : e;
+    }
+
+    double value = double(mantissa);
+    if (exponent > 0)
+        value = exponent <= 22 ? value * kPow10[exponent] : value * std::pow(10.0, exponent);
+    else if (exponent < 0)
+        value = exponent >= -22 ? value / kPow10[-exponent] : value * std::pow(10.0, exponent);
+
+    out = float(negative ? -value : value);
+    return p;
+}
+
+const char *parseInt(const char *p, const char *end, int64_t &out)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) { negative = *p == '-'; ++p; }
+    if (p >= end || unsigned(*p - '0') >= 10) return nullptr;
+
+    int64_t value = 0;
+    for (; p < end && unsigned(*p - '0') < 10; ++p)
+        if (value < (int64_t(1) << 40)) value = value * 10 + (*p - '0');
+    out = negative ? -value : value;
+    return p;
+}
+
+// OBJ index'i (1 tabanlı, negatifse göreli) -> 0 tabanlı global index
+inline bool resolveIndex(int64_t raw, size_t base, size_t localCount, uint32_t &out)
+{
+    if (raw > 0) {
+        if (raw - 1 >= int64_t(kMissing)) return false;
+        out = uint32_t(raw - 1);
+        return true;
+    }
+    if (raw < 0) {
+        const int64_t absolute = int64_t(base + localCount) + raw;
+        if (absolute < 0) return false;
+        out = uint32_t(absolute);
+        return true;
+    }
+    return false;
+}
+
+inline uint64_t hashCorner(const uint32_t *c)
+{
+    uint64_t h = uint64_t(c[0]) * 0x9E3779B97F4A7C15ull;
+    h ^= uint64_t(c[1]) * 0xC2B2AE3D27D4EB4Full;
+    h ^= uint64_t(c[2]) * 0x165667B19E3779F9ull;
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ull;
+    return h ^ (h >> 32);
+}
+
+void countChunk(Chunk &c)
+{
+    for (const char *line = c.begin; line < c.end;) {
+        const char *eol = lineEnd(line, c.end);
+        const char *p = line;
+        switch (classify(p, eol)) {
+        case Position: c.positions++; break;
+        case TexCoord: c.texCoords++; break;
+        case Normal:   c.normals++;   break;
+        case Face: {
+            const size_t n = countTokens(p, eol);
+            if (n >= 3) {
+                c.faces++;
+                c.corners += n;
+                c.triangles += n - 2;
+            }
+            break;
+        }
+        default: break;
+        }
+        line = eol < c.end ? eol + 1 : c.end;
+    }
+}
+
+struct Arrays
+{
+    float    *positions;
+    float    *texCoords;
+    float    *normals;
+    uint32_t *corners;      // köşe başına v, vt, vn (yoksa kMissing)
+    uint32_t *faceSizes;
+};
+
+void parseChunk(Chunk &c, const Arrays &a)
+{
+    size_t positions = 0, texCoords = 0, normals = 0, faces = 0, corners = 0, triangles = 0;
+
+    for (const char *line = c.begin; line < c.end && c.ok;) {
+        const char *eol = lineEnd(line, c.end);
+        const char *p = line;
+
+        switch (classify(p, eol)) {
+        case Position: {
+            float *dst = a.positions + (c.positionBase + positions++) * 3;
+            for (int k = 0; k < 3 && p; ++k) p = parseFloat(p, eol, dst[k]);
+            if (!p) c.ok = false;
+            break;
+        }
+        case TexCoord: {
+            float *dst = a.texCoords + (c.texCoordBase + texCoords++) * 2;
+            p = parseFloat(p, eol, dst[0]);
+            if (!p) { c.ok = false; break; }
+            if (!parseFloat(p, eol, dst[1])) dst[1] = 0.0f;   // "vt u" da geçerli
+            break;
+        }
+        case Normal: {
+            float *dst = a.normals + (c.normalBase + normals++) * 3;
+            for (int k = 0; k < 3 && p; ++k) p = parseFloat(p, eol, dst[k]);
+            if (!p) c.ok = false;
+            break;
+        }
+        case Face: {
+            // Sayım geçişiyle aynı kural: 3'ten az köşe atlanır
+            const size_t n = countTokens(p, eol);
+            if (n < 3) break;
+
+            uint32_t *dst = a.corners + (c.cornerBase + corners) * 3;
+            for (size_t k = 0; k < n; ++k, dst += 3) {
+                p = skipSpace(p, eol);
+                int64_t v = 0, t = 0, nr = 0;
+                p = parseInt(p, eol, v);
+                if (p && p < eol && *p == '/') {
+                    ++p;
+                    if (p < eol && *p != '/') p = parseInt(p, eol, t);
+                    if (p && p < eol && *p == '/') p = parseInt(p + 1, eol, nr);
+                }
+                if (!p || (p < eol && !isSpace(*p)) ||
+                    !resolveIndex(v, c.positionBase, positions, dst[0])) {
+                    c.ok = false;
+                    break;
+                }
+                dst[1] = kMissing;
+                dst[2] = kMissing;
+                if ((t && !resolveIndex(t, c.texCoordBase, texCoords, dst[1])) ||
+                    (nr && !resolveIndex(nr, c.normalBase, normals, dst[2]))) {
+                    c.ok = false;
+                    break;
+                }
+            }
+            a.faceSizes[c.faceBase + faces++] = uint32_t(n);
+            corners += n;
+            triangles += n - 2;
+            break;
+        }
+        case Group:
+            c.markers.push_back({c.triangleBase + triangles, false, restOfLine(p, eol)});
+            break;
+        case Material: {
+            const QByteArray name = restOfLine(p, eol);
+            if (c.firstMaterial.isEmpty()) c.firstMaterial = name;
+            c.markers.push_back({c.triangleBase + triangles, true, name});
+            break;
+        }
+        case MaterialLib:
+            if (c.materialLib.isEmpty()) c.materialLib = restOfLine(p, eol);
+            break;
+        default:
+            break;
+        }
+        line = eol < c.end ? eol + 1 : c.end;
+    }
+}
+
+// map_Kd argümanları: seçenekler (-s 1 1 1, -bm 0.5 ...) dosya adından önce gelir.
+// Geri kalan satırın tamamı dosya adı (boşluk içerebilir).
+QByteArray mapFileName(const QByteArray &args)
+{
+    static const QHash<QByteArray, int> fixedArgs = {
+        {"-blendu", 1}, {"-blendv", 1}, {"-cc", 1}, {"-clamp", 1}, {"-texres", 1},
+        {"-bm", 1}, {"-boost", 1}, {"-imfchan", 1}, {"-type", 1}, {"-mm", 2},
+    };
+
+    int pos = 0;
+    auto skipSpaces = [&]() { while (pos < args.size() && (args[pos] == ' ' || args[pos] == '\t')) ++pos; };
+    auto nextToken = [&]() {
+        skipSpaces();
+        const int start = pos;
+        while (pos < args.size() && args[pos] != ' ' && args[pos] != '\t') ++pos;
+        return args.mid(start, pos - start);
+    };
+
+    for (;;) {
+        skipSpaces();
+        const int optionStart = pos;
+        const QByteArray option = nextToken();
+        if (!option.startsWith('-')) {
+            pos = optionStart;
+            break;
+        }
+        if (option == "-o" || option == "-s" || option == "-t") {
+            // 1-3 sayı
+            for (int i = 0; i < 3; ++i) {
+                const int valueStart = pos;
+                bool number = false;
+                nextToken().toFloat(&number);
+                if (!number) { pos = valueStart; break; }
+            }
+        } else {
+            for (int i = fixedArgs.value(option, 0); i > 0; --i) nextToken();
+        }
+    }
+    return args.mid(pos).trimmed();
+}
+
+// .mtl'den diffuse texture (map_Kd) - tercihen ilk kullanılan malzemeninki
+QString findDiffuseMap(const QString &mtlPath, const QByteArray &preferredMaterial)
+{
+    QFile file(mtlPath);
+    if (!file.open(QIODevice::ReadOnly)) return QString();
+
+    QByteArray current, firstMap;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.startsWith("newmtl ")) {
+            current = line.mid(7).trimmed();
+        } else if (line.startsWith("map_Kd ")) {
+            const QByteArray map = mapFileName(line.mid(7));
+            if (current == preferredMaterial) return QString::fromUtf8(map);
+            if (firstMap.isEmpty()) firstMap = map;
+        }
+    }
+    return QString::fromUtf8(firstMap);
+}
+
+QString resolveRelative(const QString &dir, const QString &reference)
+{
+    // loadTexture ile aynı: model dizini + "/" + referans, yoksa sadece dosya adı
+    const QString relative = dir + "/" + reference;
+    if (QFileInfo::exists(relative)) return relative;
+    const QString byName = dir + "/" + QFileInfo(reference).fileName();
+    return QFileInfo::exists(byName) ? byName : QString();
+}
+
+} // namespace
+
+bool ObjLoader::isEnabledFor(const QString &path)
+{
+    if (QFileInfo(path).suffix().compare("obj", Qt::CaseInsensitive) != 0) return false;
+    bool ok = false;
+    const int enabled = qEnvironmentVariableIntValue("DESKTOPVIEWER_FAST_OBJ", &ok);
+    return !ok || enabled != 0;
+}
+
+bool ObjLoader::load(const QString &path, PackedScene &out, QStringList *dependencies)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) return false;
+    const size_t size = size_t(file.size());
+    const char *data = reinterpret_cast<const char*>(file.map(0, qint64(size)));
+    if (!data) return false;
+    const char *end = data + size;
+
+    // 1. Satır sınırlarında parçalara böl
+    const size_t threads = size_t(std::max(1, QThread::idealThreadCount()));
+    const size_t chunkBytes = std::max<size_t>(size_t(4) << 20, size / (threads * 4));
+    std::vector<Chunk> chunks;
+    for (const char *p = data; p < end;) {
+        const char *e = p + std::min(chunkBytes, size_t(end - p));
+        if (e < end) {
+            e = lineEnd(e, end);
+            if (e < end) ++e;
+        }
+        Chunk c;
+        c.begin = p;
+        c.end = e;
+        chunks.push_back(c);
+        p = e;
+    }
+
+    // 2. Paralel sayım + prefix sum -> her parçanın global offset'leri
+    parallelFor(chunks.size(), 1, [&](size_t begin, size_t endChunk) {
+        for (size_t i = begin; i < endChunk; ++i) countChunk(chunks[i]);
+    });
+
+    size_t positionCount = 0, texCoordCount = 0, normalCount = 0;
+    size_t faceCount = 0, cornerCount = 0, triangleCount = 0;
+    for (Chunk &c : chunks) {
+        c.positionBase = positionCount;  positionCount += c.positions;
+        c.texCoordBase = texCoordCount;  texCoordCount += c.texCoords;
+        c.normalBase   = normalCount;    normalCount   += c.normals;
+        c.faceBase     = faceCount;      faceCount     += c.faces;
+        c.cornerBase   = cornerCount;    cornerCount   += c.corners;
+        c.triangleBase = triangleCount;  triangleCount += c.triangles;
+    }
+    if (positionCount == 0 || triangleCount == 0 || cornerCount >= kMissing ||
+        positionCount >= kMissing) {
+        printf("OBJ hızlı yol: desteklenmeyen içerik (%zu vertex, %zu üçgen)\n", positionCount, triangleCount);
+        return false;
+    }
+
+    // 3. Paralel parse - doğrudan son dizilere
+    std::vector<float>    positions(positionCount * 3);
+    std::vector<float>    texCoords(texCoordCount * 2);
+    std::vector<float>    normals(normalCount * 3);
+    std::vector<uint32_t> corners(cornerCount * 3);
+    std::vector<uint32_t> faceSizes(faceCount);
+    const Arrays arrays = {positions.data(), texCoords.data(), normals.data(), corners.data(), faceSizes.data()};
+
+    parallelFor(chunks.size(), 1, [&](size_t begin, size_t endChunk) {
+        for (size_t i = begin; i < endChunk; ++i) parseChunk(chunks[i], arrays);
+    });
+    for (const Chunk &c : chunks) {
+        if (!c.ok) {
+            printf("OBJ hızlı yol: parse hatası\n");
+            return false;
+        }
+    }
+
+    // Index sınırları (pozitif index'ler dosyanın sonrasını gösterebilir)
+    std::atomic<bool> badIndex{false};
+    parallelFor(cornerCount, kBlock, [&](size_t begin, size_t endCorner) {
+        for (size_t i = begin; i < endCorner; ++i) {
+            const uint32_t *c = &corners[i * 3];
+            if (c[0] >= positionCount ||
+                (c[1] != kMissing && c[1] >= texCoordCount) ||
+                (c[2] != kMissing && c[2] >= normalCount)) {
+                badIndex = true;
+                return;
+            }
+        }
+    });
+    if (badIndex) {
+        printf("OBJ hızlı yol: geçersiz index\n");
+        return false;
+    }
+    const qint64 parseMs = timer.elapsed();
+
+    // 4. Weld: aynı (v, vt, vn) üçlüleri tek vertex. Köşeler hash'in üst bitlerine
+    //    göre shard'lara dağıtılır, her shard kendi tablosunu paralel kurar.
+    const size_t blocks = (cornerCount + kBlock - 1) / kBlock;
+    std::vector<uint8_t>  shardOf(cornerCount);
+    std::vector<uint32_t> blockCounts(blocks * kShards, 0);
+    parallelFor(blocks, 1, [&](size_t begin, size_t endBlock) {
+        for (size_t b = begin; b < endBlock; ++b) {
+            uint32_t *counts = &blockCounts[b * kShards];
+            for (size_t i = b * kBlock; i < std::min(cornerCount, (b + 1) * kBlock); ++i) {
+                const uint8_t s = uint8_t(hashCorner(&corners[i * 3]) >> (64 - kShardBits));
+                shardOf[i] = s;
+                counts[s]++;
+            }
+        }
+    });
+
+    // Shard-öncelikli prefix sum: her shard'ın köşeleri dosya sırasıyla ardışık
+    std::vector<size_t> shardStart(kShards + 1, 0);
+    std::vector<size_t> blockOffsets(blocks * kShards);
+    size_t running = 0;
+    for (size_t s = 0; s < kShards; ++s) {
+        shardStart[s] = running;
+        for (size_t b = 0; b < blocks; ++b) {
+            blockOffsets[b * kShards + s] = running;
+            running += blockCounts[b * kShards + s];
+        }
+    }
+    shardStart[kShards] = running;
+
+    std::vector<uint32_t> order(cornerCount);
+    parallelFor(blocks, 1, [&](size_t begin, size_t endBlock) {
+        for (size_t b = begin; b < endBlock; ++b) {
+            size_t *offsets = &blockOffsets[b * kShards];
+            for (size_t i = b * kBlock; i < std::min(cornerCount, (b + 1) * kBlock); ++i)
+                order[offsets[shardOf[i]]++] = uint32_t(i);
+        }
+    });
+
+    std::vector<uint32_t> remap(cornerCount);               // köşe -> shard içi vertex
+    std::vector<std::vector<uint32_t>> uniques(kShards);    // shard içi vertex -> temsilci köşe
+    parallelFor(kShards, 1, [&](size_t begin, size_t endShard) {
+        for (size_t s = begin; s < endShard; ++s) {
+            const size_t first = shardStart[s], count = shardStart[s + 1] - first;
+            size_t capacity = 16;
+            while (capacity < count * 2) capacity <<= 1;
+            std::vector<uint32_t> table(capacity, kMissing);
+            std::vector<uint32_t> &unique = uniques[s];
+
+            for (size_t i = first; i < first + count; ++i) {
+                const uint32_t corner = order[i];
+                const uint32_t *key = &corners[size_t(corner) * 3];
+                for (size_t slot = hashCorner(key) & (capacity - 1);; slot = (slot + 1) & (capacity - 1)) {
+                    const uint32_t entry = table[slot];
+                    if (entry == kMissing) {
+                        table[slot] = uint32_t(unique.size());
+                        remap[corner] = uint32_t(unique.size());
+                        unique.push_back(corner);
+                        break;
+                    }
+                    if (memcmp(&corners[size_t(unique[entry]) * 3], key, 3 * sizeof(uint32_t)) == 0) {
+                        remap[corner] = entry;
+                        break;
+                    }
+                }
+            }
+        }
+    });
+
+    // İlk görülme sırasına göre global vertex numarası (Assimp'in birleştirme
+    // sırasıyla aynı) - temsilci köşeler üzerinde blok bazlı paralel tarama
+    std::vector<uint8_t> isRepresentative(cornerCount, 0);
+    for (const std::vector<uint32_t> &unique : uniques)
+        for (uint32_t corner : unique) isRepresentative[corner] = 1;
+
+    std::vector<uint32_t> &vertexOf = order;   // order artık gerekmiyor - yeniden kullan
+    std::vector<size_t> blockFirstVertex(blocks + 1, 0);
+    parallelFor(blocks, 1, [&](size_t begin, size_t endBlock) {
+        for (size_t b = begin; b < endBlock; ++b) {
+            size_t n = 0;
+            for (size_t i = b * kBlock; i < std::min(cornerCount, (b + 1) * kBlock); ++i)
+                n += isRepresentative[i];
+            blockFirstVertex[b + 1] = n;
+        }
+    });
+    for (size_t b = 0; b < blocks; ++b) blockFirstVertex[b + 1] += blockFirstVertex[b];
+    const size_t vertexCount = blockFirstVertex[blocks];
+
+    parallelFor(blocks, 1, [&](size_t begin, size_t endBlock) {
+        for (size_t b = begin; b < endBlock; ++b) {
+            uint32_t next = uint32_t(blockFirstVertex[b]);
+            for (size_t i = b * kBlock; i < std::min(cornerCount, (b + 1) * kBlock); ++i)
+                if (isRepresentative[i]) vertexOf[i] = next++;
+        }
+    });
+    parallelFor(cornerCount, kBlock, [&](size_t begin, size_t endCorner) {
+        for (size_t i = begin; i < endCorner; ++i)
+            remap[i] = vertexOf[uniques[shardOf[i]][remap[i]]];
+    });
+
+    // 5. Vertex'leri yaz: position + texCoord + normal (packMeshes düzeni)
+    const int stride = PackedScene::kFloatsPerVertex;
+    out = PackedScene();
+    out.verts.resize(vertexCount * stride);
+    std::vector<uint32_t> vertexPosition(vertexCount);
+    std::vector<uint8_t>  needsNormal(vertexCount, 0);
+    std::atomic<bool> missingNormals{false};
+
+    parallelFor(kShards, 1, [&](size_t begin, size_t endShard) {
+        bool missing = false;
+        for (size_t s = begin; s < endShard; ++s) {
+            for (uint32_t corner : uniques[s]) {
+                const uint32_t *c = &corners[size_t(corner) * 3];
+                const uint32_t v = vertexOf[corner];
+                float *dst = out.verts.data() + size_t(v) * stride;
+                vertexPosition[v] = c[0];
+
+                memcpy(dst, &positions[size_t(c[0]) * 3], 3 * sizeof(float));
+                if (c[1] != kMissing) {
+                    // Assimp FlipUVs + packMeshes'teki 1 - v birbirini götürür
+                    dst[3] = qBound(0.0f, texCoords[size_t(c[1]) * 2], 1.0f);
+                    dst[4] = qBound(0.0f, texCoords[size_t(c[1]) * 2 + 1], 1.0f);
+                } else {
+                    dst[3] = 0.5f;
+                    dst[4] = 0.5f;
+                }
+                if (c[2] != kMissing) {
+                    memcpy(dst + 5, &normals[size_t(c[2]) * 3], 3 * sizeof(float));
+                } else {
+                    dst[5] = 0.0f; dst[6] = 1.0f; dst[7] = 0.0f;
+                    needsNormal[v] = 1;
+                    missing = true;
+                }
+            }
+        }
+        if (missing) missingNormals = true;
+    });
+    order = std::vector<uint32_t>();
+    uniques = std::vector<std::vector<uint32_t>>();
+
+    // 6. Üçgenleme (fan) - her parça kendi face/köşe aralığını yazar
+    out.idx.resize(triangleCount * 3);
+    parallelFor(chunks.size(), 1, [&](size_t begin, size_t endChunk) {
+        for (size_t ci = begin; ci < endChunk; ++ci) {
+            const Chunk &c = chunks[ci];
+            size_t corner = c.cornerBase;
+            unsigned *dst = out.idx.data() + c.triangleBase * 3;
+            for (size_t f = c.faceBase; f < c.faceBase + c.faces; ++f) {
+                const uint32_t n = faceSizes[f];
+                for (uint32_t k = 1; k + 1 < n; ++k) {
+                    *dst++ = remap[corner];
+                    *dst++ = remap[corner + k];
+                    *dst++ = remap[corner + k + 1];
+                }
+                corner += n;
+            }
+        }
+    });
+
+    // 7. vn olmayan köşeler için yumuşak normal (GenSmoothNormals gibi aynı
+    //    konumu paylaşan tüm üçgenlerin normal ortalaması)
+    if (missingNormals) {
+        std::vector<float> faceNormals(triangleCount * 3);
+        parallelFor(triangleCount, 65536, [&](size_t begin, size_t endTri) {
+            for (size_t t = begin; t < endTri; ++t) {
+                const float *a = &positions[size_t(vertexPosition[out.idx[t * 3 + 0]]) * 3];
+                const float *b = &positions[size_t(vertexPosition[out.idx[t * 3 + 1]]) * 3];
+                const float *c = &positions[size_t(vertexPosition[out.idx[t * 3 + 2]]) * 3];
+                const float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+                const float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+                float *n = &faceNormals[t * 3];
+                n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+                n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+                n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+                const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (len > 0.0f) { n[0] /= len; n[1] /= len; n[2] /= len; }
+            }
+        });
+
+        // Konum -> üçgen listesi (CSR)
+        std::unique_ptr<std::atomic<uint32_t>[]> fill(new std::atomic<uint32_t>[positionCount]);
+        parallelFor(positionCount, 65536, [&](size_t begin, size_t endPos) {
+            for (size_t p = begin; p < endPos; ++p) fill[p].store(0, std::memory_order_relaxed);
+        });
+        parallelFor(triangleCount, 65536, [&](size_t begin, size_t endTri) {
+            for (size_t t = begin; t < endTri; ++t)
+                for (int k = 0; k < 3; ++k)
+                    fill[vertexPosition[out.idx[t * 3 + k]]].fetch_add(1, std::memory_order_relaxed);
+        });
+        std::vector<uint32_t> firstRef(positionCount + 1, 0);
+        for (size_t p = 0; p < positionCount; ++p) {
+            firstRef[p + 1] = firstRef[p] + fill[p].load(std::memory_order_relaxed);
+            fill[p].store(0, std::memory_order_relaxed);
+        }
+        std::vector<uint32_t> refs(firstRef[positionCount]);
+        parallelFor(triangleCount, 65536, [&](size_t begin, size_t endTri) {
+            for (size_t t = begin; t < endTri; ++t)
+                for (int k = 0; k < 3; ++k) {
+                    const uint32_t p = vertexPosition[out.idx[t * 3 + k]];
+                    refs[firstRef[p] + fill[p].fetch_add(1, std::memory_order_relaxed)] = uint32_t(t);
+                }
+        });
+
+        std::vector<float> positionNormals(positionCount * 3);
+        parallelFor(positionCount, 65536, [&](size_t begin, size_t endPos) {
+            for (size_t p = begin; p < endPos; ++p) {
+                float n[3] = {0, 0, 0};
+                for (uint32_t r = firstRef[p]; r < firstRef[p + 1]; ++r)
+                    for (int k = 0; k < 3; ++k) n[k] += faceNormals[size_t(refs[r]) * 3 + k];
+                const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                float *dst = &positionNormals[p * 3];
+                if (len > 0.0f) {
+                    dst[0] = n[0] / len; dst[1] = n[1] / len; dst[2] = n[2] / len;
+                } else {
+                    dst[0] = 0.0f; dst[1] = 1.0f; dst[2] = 0.0f;
+                }
+            }
+        });
+
+        parallelFor(vertexCount, 65536, [&](size_t begin, size_t endVertex) {
+            for (size_t v = begin; v < endVertex; ++v) {
+                float *dst = out.verts.data() + v * stride;
+                if (needsNormal[v])
+                    memcpy(dst + 5, &positionNormals[size_t(vertexPosition[v]) * 3], 3 * sizeof(float));
+            }
+        });
+    }
+
+    // 8. Bounds (computeBounds ile aynı merkez/yarıçap hesabı)
+    const size_t boundBlocks = (vertexCount + 65535) / 65536;
+    std::vector<float> partial(boundBlocks * 6);
+    parallelFor(vertexCount, 65536, [&](size_t begin, size_t endVertex) {
+        // Tek çekirdekte parallelFor tüm aralığı tek çağrıda verir - her blok ayrı doldurulur
+        for (size_t b = begin / 65536; b <= (endVertex - 1) / 65536; ++b) {
+            const size_t first = std::max(begin, b * 65536);
+            const size_t last = std::min(endVertex, (b + 1) * 65536);
+            float *mn = &partial[b * 6], *mx = mn + 3;
+            for (int k = 0; k < 3; ++k) mn[k] = mx[k] = out.verts[first * stride + k];
+            for (size_t v = first; v < last; ++v)
+                for (int k = 0; k < 3; ++k) {
+                    const float x = out.verts[v * stride + k];
+                    mn[k] = std::min(mn[k], x);
+                    mx[k] = std::max(mx[k], x);
+                }
+        }
+    });
+    float mn[3] = {partial[0], partial[1], partial[2]};
+    float mx[3] = {partial[3], partial[4], partial[5]};
+    for (size_t b = 1; b < boundBlocks; ++b)
+        for (int k = 0; k < 3; ++k) {
+            mn[k] = std::min(mn[k], partial[b * 6 + k]);
+            mx[k] = std::max(mx[k], partial[b * 6 + 3 + k]);
+        }
+    out.boundingMin = QVector3D(mn[0], mn[1], mn[2]);
+    out.boundingMax = QVector3D(mx[0], mx[1], mx[2]);
+    out.center = (out.boundingMin + out.boundingMax) * 0.5f;
+    const QVector3D extent = out.boundingMax - out.boundingMin;
+    out.radius = qMax(qMax(extent.x(), extent.y()), extent.z()) * 0.6f;
+
+    // 9. o/g/usemtl işaretlerinden picking aralıkları
+    PackedScene::MeshRange range;
+    QByteArray group, material;
+    auto close = [&](size_t triangle) {
+        range.triangleCount = unsigned(triangle) - range.firstTriangle;
+        if (range.triangleCount > 0) {
+            range.sourceMesh = unsigned(out.meshes.size());
+            range.name = QString::fromUtf8(group);
+            range.materialName = QString::fromUtf8(material);
+            out.meshes.push_back(range);
+        }
+        range.firstTriangle = unsigned(triangle);
+    };
+    QByteArray materialLib, firstMaterial;
+    for (const Chunk &c : chunks) {
+        for (const Marker &m : c.markers) {
+            close(m.triangle);
+            (m.material ? material : group) = m.name;
+        }
+        if (materialLib.isEmpty()) materialLib = c.materialLib;
+        if (firstMaterial.isEmpty()) firstMaterial = c.firstMaterial;
+    }
+    close(triangleCount);
+
+    // 10. Diffuse texture (.mtl map_Kd)
+    const QString modelDir = QFileInfo(path).absolutePath();
+    if (!materialLib.isEmpty()) {
+        const QString mtlPath = resolveRelative(modelDir, QString::fromUtf8(materialLib));
+        if (!mtlPath.isEmpty()) {
+            if (dependencies) dependencies->append(mtlPath);
+            const QString map = findDiffuseMap(mtlPath, firstMaterial);
+            const QString texturePath = map.isEmpty() ? QString() : resolveRelative(modelDir, map);
+            QImage image;
+            if (!texturePath.isEmpty() && image.load(texturePath)) {
+                out.texture = SceneData::toGLImage(image);
+                if (dependencies) dependencies->append(texturePath);
+            }
+        }
+    }
+
+    out.cacheVariant = "objfast";
+    printf("OBJ hızlı yol: %zu vertex, %zu üçgen, %zu parça, parse %lld ms, toplam %lld ms (%zu thread)\n",
+           vertexCount, triangleCount, chunks.size(), (long long)parseMs,
+           (long long)timer.elapsed(), threads);
+    return true;
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <QString>
+#include <QStringList>
+#include "scenedata.h"
+
+// Büyük OBJ taramaları için Assimp'siz, çok çekirdekli hızlı yol.
+// Dosya mmap edilir, satır sınırlarında parçalara bölünür; parçalar önce
+// sayılır (prefix sum ile global offset'ler), sonra paralel olarak doğrudan
+// son dizilere parse edilir. v/vt/vn üçlüleri paralel, shard'lı bir hash ile
+// birleştirilir (JoinIdenticalVertices karşılığı), vn yoksa yumuşak normal
+// üretilir. Çıktı SceneData::packMeshes ile aynı PackedScene düzenidir.
+namespace ObjLoader
+{
+    // Desteklenmeyen/bozuk dosyada false döner - çağıran Assimp'e düşer.
+    // dependencies: okunan .mtl ve texture dosyaları (hot reload izlemesi için)
+    bool load(const QString &path, PackedScene &out, QStringList *dependencies = nullptr);
+
+    // .obj uzantısı ve DESKTOPVIEWER_FAST_OBJ (=0 ise kapalı)
+    bool isEnabledFor(const QString &path);
+}
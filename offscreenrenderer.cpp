@@ -0,0 +1,303 @@
+#include "offscreenrenderer.h"
+#include "shaders.h"
+#include <QSurfaceFormat>
+#include <cstring>
+
+static QSurfaceFormat offscreenFormat()
+{
+    QSurfaceFormat fmt;
+    fmt.setVersion(3, 3);
+    fmt.setProfile(QSurfaceFormat::CoreProfile);
+    fmt.setDepthBufferSize(24);
+    return fmt;
+}
+
+OffscreenRenderer::OffscreenRenderer()
+    : surface(new QOffscreenSurface),
+      glContext(new QOpenGLContext)
+{
+    const QSurfaceFormat fmt = offscreenFormat();
+    surface->setFormat(fmt);
+    surface->create();
+
+    glContext->setFormat(fmt);
+    glContext->create();
+}
+
+OffscreenRenderer::~OffscreenRenderer()
+{
+    release();
+}
+
+bool OffscreenRenderer::initialize(const QSize &size)
+{
+    if (!glContext->isValid() || !surface->isValid()) {
+        printf("Offscreen context oluşturulamadı\n");
+        return false;
+    }
+    if (!glContext->makeCurrent(surface.get())) {
+        printf("Offscreen context aktif edilemedi\n");
+        return false;
+    }
+    if (!initializeOpenGLFunctions()) {
+        printf("OpenGL 3.3 fonksiyonları yüklenemedi\n");
+        glContext->doneCurrent();
+        return false;
+    }
+
+    glEnable(GL_DEPTH_TEST);
+
+    // Düzleştirilmiş sahne çizilir - instance (location 4-7) ve normal (8-10) matrisleri birim
+    for (int c = 0; c < 4; ++c)
+        glVertexAttrib4f(4 + c, c == 0, c == 1, c == 2, c == 3);
+    for (int c = 0; c < 3; ++c)
+        glVertexAttrib3f(8 + c, c == 0, c == 1, c == 2);
+
+    shader = new QOpenGLShaderProgram;
+    shader->addShaderFromSourceCode(QOpenGLShader::Vertex, Shaders::vertex);
+    shader->addShaderFromSourceCode(QOpenGLShader::Fragment, Shaders::fragment);
+    if (!shader->link()) {
+        printf("Offscreen shader link hatası: %s\n", shader->log().toStdString().c_str());
+        delete shader;
+        shader = nullptr;
+        glContext->doneCurrent();
+        return false;
+    }
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    glGenBuffers(1, &aoVbo);
+    glGenFramebuffers(1, &fbo);
+    glGenRenderbuffers(1, &colorRbo);
+    glGenRenderbuffers(1, &depthRbo);
+    for (Readback &slot : ring)
+        glGenBuffers(1, &slot.pbo);
+
+    setSize(size);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        // Çağıranlar başarısız initialize sonrası release() çağırmaz
+        printf("Offscreen framebuffer eksik\n");
+        release();
+        return false;
+    }
+    return true;
+}
+
+void OffscreenRenderer::release()
+{
+    if (!shader) return;   // initialize hiç çağrılmadı
+
+    glContext->makeCurrent(surface.get());
+    finish();
+
+    for (Readback &slot : ring)
+        glDeleteBuffers(1, &slot.pbo);
+    if (textureID) glDeleteTextures(1, &textureID);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(1, &colorRbo);
+    glDeleteRenderbuffers(1, &depthRbo);
+    glDeleteBuffers(1, &vbo);
+    glDeleteBuffers(1, &ebo);
+    glDeleteBuffers(1, &aoVbo);
+    glDeleteVertexArrays(1, &vao);
+
+    delete shader;
+    shader = nullptr;
+    textureID = 0;
+    indexCount = 0;
+    targetSize = QSize();   // tekrar initialize edilirse depolar yeniden ayrılsın
+
+    glContext->doneCurrent();
+}
+
+void OffscreenRenderer::setSize(const QSize &size)
+{
+    if (size == targetSize) return;
+
+    // Eski boyuttaki readback'ler önce bitsin
+    finish();
+    targetSize = size;
+
+    glBindRenderbuffer(GL_RENDERBUFFER, colorRbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size.width(), size.height());
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRbo);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size.width(), size.height());
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRbo);
+
+    // PBO'lar tam kare boyutunda
+    const GLsizeiptr bytes = GLsizeiptr(size.width()) * size.height() * 4;
+    for (Readback &slot : ring) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+bool OffscreenRenderer::uploadScene(const PackedScene &scene)
+{
+    if (scene.isEmpty()) return false;
+
+    // Önceki modelin readback'leri eski buffer'ları kullanıyor olabilir
+    finish();
+
+    boundingMin = scene.boundingMin;
+    boundingMax = scene.boundingMax;
+    modelRadius = scene.radius;
+    indexCount  = int(scene.idx.size());
+
+    glBindVertexArray(vao);
+
+    // Her model için yeniden ayır (orphan) - sürücü eski veriyi beklemez
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, scene.verts.size() * sizeof(float), scene.verts.data(), GL_STATIC_DRAW);
+
+    // position(3) + texCoord(2) + normal(3) - GLViewport ile aynı düzen
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(5 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, scene.idx.size() * sizeof(unsigned), scene.idx.data(), GL_STATIC_DRAW);
+
+    // AO (location = 3)
+    if (scene.ao.size() == size_t(scene.vertexCount())) {
+        glBindBuffer(GL_ARRAY_BUFFER, aoVbo);
+        glBufferData(GL_ARRAY_BUFFER, scene.ao.size() * sizeof(float), scene.ao.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
+        glEnableVertexAttribArray(3);
+    } else {
+        glDisableVertexAttribArray(3);
+        glVertexAttrib1f(3, 1.0f);
+    }
+
+    glBindVertexArray(0);
+
+    // Texture
+    if (textureID) {
+        glDeleteTextures(1, &textureID);
+        textureID = 0;
+    }
+    hasTexture = !scene.texture.isNull();
+    if (hasTexture) {
+        glGenTextures(1, &textureID);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+                     scene.texture.width(), scene.texture.height(), 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, scene.texture.constBits());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    return glGetError() == GL_NO_ERROR;
+}
+
+void OffscreenRenderer::drawScene(const CameraPose &pose)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, targetSize.width(), targetSize.height());
+    glClearColor(0.2f, 0.3f, 0.4f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    if (indexCount == 0) return;
+
+    QMatrix4x4 projection;
+    projection.perspective(45.f, float(targetSize.width()) / qMax(1, targetSize.height()), 0.1f, 100.f);
+    const QMatrix4x4 view  = SceneData::orbitView(pose.yaw, pose.pitch, pose.distance * modelRadius);
+    const QMatrix4x4 model = SceneData::framingModel(boundingMin, boundingMax);
+
+    shader->bind();
+    shader->setUniformValue("mvp", projection * view * model);
+    if (hasTexture) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        shader->setUniformValue("ourTexture", 0);
+    }
+    shader->setUniformValue("hasTexture", GLint(hasTexture ? 1 : 0));
+
+    glBindVertexArray(vao);
+    glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(0);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    shader->release();
+}
+
+void OffscreenRenderer::render(const CameraPose &pose, FrameCallback done, uchar *target)
+{
+    Readback &slot = ring[nextSlot];
+    nextSlot = (nextSlot + 1) % kReadbackSlots;
+
+    // Halka doluysa en eski kareyi teslim et - GPU bu arada yeni kareyi çizer
+    if (slot.fence)
+        completeReadback(slot);
+
+    drawScene(pose);
+
+    // FBO -> PBO kopyası GPU tarafında kuyruğa girer, CPU beklemez
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glReadPixels(0, 0, targetSize.width(), targetSize.height(), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.size  = targetSize;
+    slot.done  = std::move(done);
+    slot.target = target;
+    glFlush();
+}
+
+void OffscreenRenderer::finish()
+{
+    // Gönderim sırasıyla tamamla (nextSlot en eski kare)
+    for (int i = 0; i < kReadbackSlots; ++i) {
+        Readback &slot = ring[(nextSlot + i) % kReadbackSlots];
+        if (slot.fence)
+            completeReadback(slot);
+    }
+}
+
+void OffscreenRenderer::completeReadback(Readback &slot)
+{
+    while (glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000) == GL_TIMEOUT_EXPIRED) {
+        // 100 ms'lik aralarla bekle
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    const int w = slot.size.width();
+    const int h = slot.size.height();
+    const int rowBytes = w * 4;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    const uchar *src = static_cast<const uchar*>(
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(rowBytes) * h, GL_MAP_READ_BIT));
+
+    QImage frame;
+    if (src) {
+        // OpenGL alttan başlar - satırları ters çevirerek kopyala
+        frame = slot.target ? QImage(slot.target, w, h, rowBytes, QImage::Format_RGBA8888)
+                            : QImage(w, h, QImage::Format_RGBA8888);
+        for (int y = 0; y < h; ++y)
+            memcpy(frame.scanLine(h - 1 - y), src + size_t(y) * rowBytes, rowBytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        printf("PBO map edilemedi\n");
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    FrameCallback done = std::move(slot.done);
+    slot.done = nullptr;
+    slot.target = nullptr;
+    if (done) done(frame);
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <QOpenGLContext>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLShaderProgram>
+#include <QOffscreenSurface>
+#include <QMatrix4x4>
+#include <QImage>
+#include <QSize>
+#include <functional>
+#include <memory>
+#include "scenedata.h"
+
+// Pencere olmadan (headless) FBO'ya çizim yapan renderer.
+// Kendi QOpenGLContext'i vardır; bir worker thread'de kullanılabilir.
+// Readback PBO halkası + fence ile asenkron: render() bir önceki karenin
+// okunmasını beklemeden döner, sonuç hazır olunca callback çağrılır.
+class OffscreenRenderer : protected QOpenGLFunctions_3_3_Core
+{
+public:
+    using FrameCallback = std::function<void(const QImage &frame)>;
+
+    // GUI thread'de oluşturulmalı (QOffscreenSurface kuralı)
+    OffscreenRenderer();
+    ~OffscreenRenderer();
+
+    QOpenGLContext *context() const { return glContext.get(); }
+
+    // Context'in kullanılacağı thread'de çağrılır
+    bool initialize(const QSize &size);
+    void release();
+
+    void setSize(const QSize &size);
+    QSize size() const { return targetSize; }
+
+    bool uploadScene(const PackedScene &scene);
+    bool hasScene() const { return indexCount > 0; }
+
+    // target verilirse (en az genişlik * yükseklik * 4 bayt) PBO satırları doğrudan
+    // oraya yazılır ve callback'teki kare onu sarar - ara QImage kopyası yok
+    void render(const CameraPose &pose, FrameCallback done, uchar *target = nullptr);
+    void finish();   // bekleyen tüm readback'leri tamamla
+
+private:
+    struct Readback {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        QSize size;
+        FrameCallback done;
+        uchar *target = nullptr;
+    };
+
+    void drawScene(const CameraPose &pose);
+    void completeReadback(Readback &slot);
+
+    std::unique_ptr<QOffscreenSurface> surface;
+    std::unique_ptr<QOpenGLContext>    glContext;
+    QOpenGLShaderProgram *shader = nullptr;
+
+    QSize  targetSize;
+    GLuint fbo = 0, colorRbo = 0, depthRbo = 0;
+    GLuint vao = 0, vbo = 0, ebo = 0, aoVbo = 0, textureID = 0;
+    int    indexCount = 0;
+    bool   hasTexture = false;
+
+    QVector3D boundingMin, boundingMax;
+    float     modelRadius = 1.0f;
+
+    static constexpr int kReadbackSlots = 3;
+    Readback ring[kReadbackSlots];
+    int      nextSlot = 0;
+};
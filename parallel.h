@@ -0,0 +1,85 @@
+#pragma once
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Basit paralel döngü: [0, count) aralığını parçalara bölüp tüm çekirdeklerde
+// çalıştırır. fn(begin, end) her parça için bir kez çağrılır. Küçük işler
+// thread açmadan çağıran thread'de biter.
+template<class Fn>
+void parallelFor(size_t count, size_t grain, Fn &&fn)
+{
+    if (count == 0) return;
+    grain = std::max<size_t>(1, grain);
+
+    const size_t chunks  = (count + grain - 1) / grain;
+    const size_t threads = std::min<size_t>(chunks, size_t(std::max(1, QThread::idealThreadCount())));
+    if (threads <= 1) {
+        fn(size_t(0), count);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (;;) {
+            const size_t chunk = next.fetch_add(1);
+            if (chunk >= chunks) break;
+            const size_t begin = chunk * grain;
+            fn(begin, std::min(count, begin + grain));
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t i = 1; i < threads; ++i)
+        pool.emplace_back(worker);
+    worker();   // çağıran thread de çalışsın
+    for (std::thread &t : pool)
+        t.join();
+}
+
+// parallelTeam içindeki thread'lerin adım adım ilerlemesi için bekleme noktası.
+// Kısa aşamalar (kumaş çözücüsünde renk başına bir kaç mikrosaniye) için
+// uyuyan bir kilit yerine spin + yield.
+class SpinBarrier
+{
+public:
+    explicit SpinBarrier(size_t count) : count(count) {}
+
+    void wait()
+    {
+        const size_t gen = generation.load(std::memory_order_acquire);
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        for (int spins = 0; generation.load(std::memory_order_acquire) == gen; ++spins)
+            if (spins > 64) std::this_thread::yield();
+    }
+
+private:
+    const size_t        count;
+    std::atomic<size_t> arrived{0};
+    std::atomic<size_t> generation{0};
+};
+
+// Sabit sayıda thread'i bir kez açıp aynı fn'i hepsinde çalıştırır:
+// fn(index, threads, barrier). parallelFor'dan farkı, aşamalar arasında
+// thread'leri yeniden açmadan barrier ile senkronlanabilmesi.
+template<class Fn>
+void parallelTeam(size_t threads, Fn &&fn)
+{
+    threads = std::max<size_t>(1, threads);
+    SpinBarrier barrier(threads);
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t i = 1; i < threads; ++i)
+        pool.emplace_back([&, i]() { fn(i, threads, barrier); });
+    fn(size_t(0), threads, barrier);
+    for (std::thread &t : pool)
+        t.join();
+}
@@ -0,0 +1,124 @@
+#include "picking.h"
+#include "modelcache.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr quint32 kCacheMagic = 0x32485642;   // "BVH2" - derinlik sınırlı ağaç
+
+struct BvhCacheHeader {
+    quint32 magic;
+    quint32 triangleCount;
+    quint32 nodeCount;
+    quint32 packCount;
+};
+
+bool readCache(TriangleBVH &bvh, const QByteArray &data, size_t triangleCount)
+{
+    if (size_t(data.size()) < sizeof(BvhCacheHeader)) return false;
+
+    BvhCacheHeader header;
+    memcpy(&header, data.constData(), sizeof(header));
+    if (header.magic != kCacheMagic || header.triangleCount != triangleCount) return false;
+
+    const size_t nodeBytes = size_t(header.nodeCount) * sizeof(TriangleBVH::Node);
+    const size_t packBytes = size_t(header.packCount) * sizeof(TriangleBVH::TriPack);
+    if (size_t(data.size()) != sizeof(header) + nodeBytes + packBytes) return false;
+
+    const char *src = data.constData() + sizeof(header);
+    bvh.nodes.resize(header.nodeCount);
+    bvh.packs.resize(header.packCount);
+    memcpy(bvh.nodes.data(), src, nodeBytes);
+    memcpy(bvh.packs.data(), src + nodeBytes, packBytes);
+    return true;
+}
+
+QByteArray writeCache(const TriangleBVH &bvh, size_t triangleCount)
+{
+    BvhCacheHeader header = {kCacheMagic, quint32(triangleCount),
+                             quint32(bvh.nodes.size()), quint32(bvh.packs.size())};
+    QByteArray data(reinterpret_cast<const char*>(&header), sizeof(header));
+    data.append(reinterpret_cast<const char*>(bvh.nodes.data()),
+                qsizetype(bvh.nodes.size() * sizeof(TriangleBVH::Node)));
+    data.append(reinterpret_cast<const char*>(bvh.packs.data()),
+                qsizetype(bvh.packs.size() * sizeof(TriangleBVH::TriPack)));
+    return data;
+}
+
+} // namespace
+
+bool Picking::loadOrBuildBVH(TriangleBVH &bvh, const PackedScene &scene, const QString &modelPath)
+{
+    const size_t triangleCount = scene.idx.size() / 3;
+    if (triangleCount == 0) {
+        bvh.clear();
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QByteArray cached;
+    if (!modelPath.isEmpty() && ModelCache::load(modelPath, scene.cacheKind("bvh"), cached) &&
+        readCache(bvh, cached, triangleCount)) {
+        printf("BVH cache'den yüklendi: %zu düğüm, %lld ms\n", bvh.nodeCount(), (long long)timer.elapsed());
+        return true;
+    }
+
+    bvh.build(scene.verts.data(), PackedScene::kFloatsPerVertex, scene.idx.data(), triangleCount);
+    printf("BVH kuruldu: %zu üçgen, %zu düğüm, %lld ms\n",
+           triangleCount, bvh.nodeCount(), (long long)timer.elapsed());
+
+    if (!modelPath.isEmpty())
+        ModelCache::save(modelPath, scene.cacheKind("bvh"), writeCache(bvh, triangleCount));
+    return true;
+}
+
+PickResult Picking::pick(const TriangleBVH &bvh, const std::vector<PackedScene::MeshRange> &meshes,
+                         const QMatrix4x4 &mvp, const QPointF &pos, const QSize &viewportSize)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    PickResult result;
+    if (bvh.isEmpty() || viewportSize.isEmpty()) return result;
+
+    // Ekran -> NDC -> model uzayı (near/far düzlemleri)
+    const float x = 2.0f * float(pos.x()) / viewportSize.width() - 1.0f;
+    const float y = 1.0f - 2.0f * float(pos.y()) / viewportSize.height();
+    bool invertible = false;
+    const QMatrix4x4 inv = mvp.inverted(&invertible);
+    if (!invertible) return result;
+
+    const QVector3D nearPt = inv.map(QVector3D(x, y, -1.0f));
+    const QVector3D farPt  = inv.map(QVector3D(x, y,  1.0f));
+    const QVector3D dir = (farPt - nearPt).normalized();
+
+    Ray ray;
+    ray.o[0] = nearPt.x(); ray.o[1] = nearPt.y(); ray.o[2] = nearPt.z();
+    ray.d[0] = dir.x();    ray.d[1] = dir.y();    ray.d[2] = dir.z();
+
+    RayHit hit;
+    if (bvh.intersect(ray, hit)) {
+        result.hit = true;
+        result.triangle = hit.triangle;
+        result.position = nearPt + dir * hit.t;
+        result.normal = QVector3D(hit.normal[0], hit.normal[1], hit.normal[2]).normalized();
+        result.u = hit.u;
+        result.v = hit.v;
+
+        // Üçgen -> kaynak mesh (aralıklar sıralı)
+        auto it = std::upper_bound(meshes.begin(), meshes.end(), hit.triangle,
+                                   [](unsigned tri, const PackedScene::MeshRange &r) { return tri < r.firstTriangle; });
+        if (it != meshes.begin()) {
+            const PackedScene::MeshRange &range = *(it - 1);
+            result.meshIndex = int(range.sourceMesh);
+            result.meshName = range.name;
+            result.materialName = range.materialName;
+        }
+    }
+    result.elapsedNs = timer.nsecsElapsed();
+    return result;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <QString>
+#include <QVector3D>
+#include <QMatrix4x4>
+#include <QPointF>
+#include <QSize>
+#include "scenedata.h"
+#include "bvh.h"
+
+// Fare ile seçilen yüzey noktası (ölçü noktası işaretleme için)
+struct PickResult
+{
+    bool      hit = false;
+    unsigned  triangle = 0;       // birleşik üçgen listesindeki sıra
+    int       meshIndex = -1;     // kaynak aiMesh
+    QString   meshName;
+    QString   materialName;
+    QVector3D position;           // model uzayında
+    QVector3D normal;
+    float     u = 0.0f, v = 0.0f; // barycentric
+    qint64    elapsedNs = 0;
+};
+
+namespace Picking
+{
+    // Cache'de varsa oradan, yoksa paralel kurup cache'e yazar
+    bool loadOrBuildBVH(TriangleBVH &bvh, const PackedScene &scene, const QString &modelPath);
+
+    // mvp = projection * view * model, pos widget koordinatı
+    PickResult pick(const TriangleBVH &bvh, const std::vector<PackedScene::MeshRange> &meshes,
+                    const QMatrix4x4 &mvp, const QPointF &pos, const QSize &viewportSize);
+}
@@ -0,0 +1,672 @@
+#include "renderserver.h"
+#include "offscreenrenderer.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSharedMemory>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <cstring>
+
+namespace {
+
+constexpr int    kMaxBatch   = 32;   // tek modelin diğerlerini aç bırakmaması için
+constexpr int    kPngQuality = 80;   // Qt PNG: yüksek kalite = düşük zlib seviyesi (hızlı)
+constexpr int    kMaxSide    = 8192;
+
+qint64 nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double toMs(qint64 ns)
+{
+    return ns / 1e6;
+}
+
+RenderReply errorReply(const RenderRequest &request, const QString &message)
+{
+    RenderReply reply;
+    reply.connection = request.connection;
+    reply.receivedNs = request.receivedNs;
+    reply.header["id"] = request.id;
+    reply.header["ok"] = false;
+    reply.header["error"] = message;
+    return reply;
+}
+
+} // namespace
+
+// Tek offscreen context'e sahip render thread'i: kuyruktan aynı modele ait
+// istekleri toplu alır, model yerleşik değilse bir kez yükler, hepsini çizer.
+class RenderThread : public QThread
+{
+public:
+    RenderThread(RenderServer &server, QThreadPool &encoders, size_t cacheBytes)
+        : server(server), encoders(encoders), cacheBytes(cacheBytes)
+    {
+        // Context bu thread'de kullanılacak
+        renderer.context()->moveToThread(this);
+    }
+
+    void enqueue(RenderRequest &&request)
+    {
+        QMutexLocker lock(&mutex);
+        queue.push_back(std::move(request));
+        wake.wakeOne();
+    }
+
+    // Kopan bağlantının kuyruktaki istekleri çizilmesin
+    void cancel(quint64 connection)
+    {
+        QMutexLocker lock(&mutex);
+        queue.erase(std::remove_if(queue.begin(), queue.end(),
+                                   [connection](const RenderRequest &r) { return r.connection == connection; }),
+                    queue.end());
+    }
+
+    void stop()
+    {
+        {
+            QMutexLocker lock(&mutex);
+            stopping = true;
+        }
+        wake.wakeAll();
+        wait();
+    }
+
+protected:
+    void run() override
+    {
+        const bool ready = renderer.initialize(QSize(256, 256));
+        if (!ready)
+            printf("Render sunucusu: offscreen OpenGL 3.3 context yok - istekler hata ile dönecek\n");
+
+        std::vector<RenderRequest> batch;
+        while (takeBatch(batch)) {
+            if (!ready) {
+                for (const RenderRequest &r : batch)
+                    server.post(errorReply(r, "OpenGL context yok"));
+                continue;
+            }
+            renderBatch(batch);
+        }
+
+        if (ready) renderer.release();
+        renderer.context()->moveToThread(QCoreApplication::instance()->thread());
+    }
+
+private:
+    struct Resident
+    {
+        std::shared_ptr<PackedScene> scene;
+        size_t  bytes = 0;
+        quint64 lastUse = 0;
+    };
+
+    // En eski isteğin modeline ait (en fazla kMaxBatch) istek, geliş sırasıyla
+    bool takeBatch(std::vector<RenderRequest> &batch)
+    {
+        batch.clear();
+        QMutexLocker lock(&mutex);
+        while (queue.empty() && !stopping)
+            wake.wait(&mutex);
+        if (stopping) return false;
+
+        const QString model = queue.front().model;
+        for (auto it = queue.begin(); it != queue.end() && int(batch.size()) < kMaxBatch;) {
+            if (it->model == model) {
+                batch.push_back(std::move(*it));
+                it = queue.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return true;
+    }
+
+    std::shared_ptr<PackedScene> residentModel(const QString &path, qint64 &loadNs, QString &error)
+    {
+        auto it = resident.find(path);
+        if (it != resident.end()) {
+            it->second.lastUse = ++useCounter;
+            return it->second.scene;
+        }
+
+        const qint64 start = nowNs();
+        auto scene = std::make_shared<PackedScene>();
+        if (!SceneData::loadScene(importer, path, *scene)) {
+            error = "Model yüklenemedi: " + path;
+            return nullptr;
+        }
+        importer.FreeScene();
+        loadNs = nowNs() - start;
+
+        // Bütçe aşılırsa en uzun süredir kullanılmayanları çıkar
+        Resident entry;
+        entry.scene = scene;
+        entry.bytes = (scene->verts.size() + scene->ao.size()) * sizeof(float)
+                    + scene->idx.size() * sizeof(unsigned) + size_t(scene->texture.sizeInBytes());
+        entry.lastUse = ++useCounter;
+        while (!resident.empty() && residentBytes + entry.bytes > cacheBytes) {
+            auto oldest = std::min_element(resident.begin(), resident.end(), [](const auto &a, const auto &b) {
+                return a.second.lastUse < b.second.lastUse;
+            });
+            residentBytes -= oldest->second.bytes;
+            resident.erase(oldest);
+        }
+        residentBytes += entry.bytes;
+        resident[path] = entry;
+        return scene;
+    }
+
+    void renderBatch(std::vector<RenderRequest> &batch)
+    {
+        const qint64 batchStart = nowNs();
+        const QString model = batch.front().model;
+
+        QString error;
+        qint64 loadNs = 0, uploadNs = 0;
+        std::shared_ptr<PackedScene> scene = residentModel(model, loadNs, error);
+        if (scene && uploadedModel != model) {
+            const qint64 start = nowNs();
+            uploadedModel = renderer.uploadScene(*scene) ? model : QString();
+            uploadNs = nowNs() - start;
+            if (uploadedModel.isEmpty()) error = "GPU'ya yüklenemedi: " + model;
+        }
+        if (!error.isEmpty()) {
+            for (const RenderRequest &r : batch)
+                server.post(errorReply(r, error));
+            return;
+        }
+
+        // Aynı boyuttakiler art arda - FBO/PBO yeniden boyutlanması azalır
+        std::stable_sort(batch.begin(), batch.end(), [](const RenderRequest &a, const RenderRequest &b) {
+            return qint64(a.size.width()) * a.size.height() < qint64(b.size.width()) * b.size.height();
+        });
+
+        const bool cached = loadNs == 0;
+        for (const RenderRequest &request : batch) {
+            renderer.setSize(request.size);
+
+            QJsonObject timing;
+            timing["queue_ms"]  = toMs(batchStart - request.receivedNs);
+            timing["load_ms"]   = toMs(loadNs);
+            timing["upload_ms"] = toMs(uploadNs);
+            timing["batch"]     = int(batch.size());
+            timing["resident"]  = cached;
+
+            // Ham kare + shm: PBO satırları doğrudan slota okunur (kodlama ve ara kopya yok)
+            RenderServer::SharedFrame shared;
+            if (request.raw && request.sharedMemory)
+                shared = server.acquireShared(request.connection,
+                                              qsizetype(request.size.width()) * request.size.height() * 4);
+            uchar *target = shared.memory ? static_cast<uchar*>(shared.memory->data()) : nullptr;
+
+            const qint64 renderStart = nowNs();
+            renderer.render(request.pose, [this, request, timing, renderStart, shared](const QImage &frame) mutable {
+                timing["render_ms"] = toMs(nowNs() - renderStart);
+
+                if (shared.memory && !frame.isNull()) {
+                    RenderReply reply = frameReply(request, frame);
+                    RenderServer::attachShared(reply, shared, frame.sizeInBytes());
+                    timing["encode_ms"] = 0.0;
+                    reply.header["timing"] = timing;
+                    server.post(std::move(reply));
+                    return;
+                }
+                if (shared.memory) server.releaseShared(request.connection, shared.slot);
+
+                // Kodlama ayrı havuzda - render thread'i sonraki kareye geçer
+                encoders.start([this, request, timing, frame]() mutable {
+                    const qint64 encodeStart = nowNs();
+                    RenderReply reply = frameReply(request, frame);
+
+                    if (frame.isNull()) {
+                        reply.header["error"] = "Readback başarısız";
+                    } else if (request.raw) {
+                        reply.frame = frame;
+                    } else {
+                        QBuffer buffer(&reply.payload);
+                        buffer.open(QIODevice::WriteOnly);
+                        frame.save(&buffer, "PNG", kPngQuality);
+                    }
+
+                    // shm istendiyse slota burada yazılır - GUI thread sadece başlığı gönderir
+                    const char *data = reply.frame.isNull() ? reply.payload.constData()
+                                                            : reinterpret_cast<const char*>(reply.frame.constBits());
+                    const qsizetype bytes = reply.frame.isNull() ? reply.payload.size() : reply.frame.sizeInBytes();
+                    if (request.sharedMemory && bytes > 0) {
+                        const RenderServer::SharedFrame shared = server.acquireShared(request.connection, bytes);
+                        if (shared.memory) {
+                            memcpy(shared.memory->data(), data, size_t(bytes));
+                            RenderServer::attachShared(reply, shared, bytes);
+                        }
+                    }
+                    timing["encode_ms"] = toMs(nowNs() - encodeStart);
+                    reply.header["timing"] = timing;
+                    server.post(std::move(reply));
+                });
+            }, target);
+        }
+        renderer.finish();
+    }
+
+    static RenderReply frameReply(const RenderRequest &request, const QImage &frame)
+    {
+        RenderReply reply;
+        reply.connection = request.connection;
+        reply.receivedNs = request.receivedNs;
+        reply.header["id"] = request.id;
+        reply.header["ok"] = !frame.isNull();
+        reply.header["width"] = frame.width();
+        reply.header["height"] = frame.height();
+        reply.header["format"] = request.raw ? "rgba" : "png";
+        return reply;
+    }
+
+    RenderServer     &server;
+    QThreadPool      &encoders;
+    OffscreenRenderer renderer;
+    QString           uploadedModel;
+    Assimp::Importer  importer;
+
+    QMutex                    mutex;
+    QWaitCondition            wake;
+    std::deque<RenderRequest> queue;
+    bool                      stopping = false;
+
+    std::map<QString, Resident> resident;
+    size_t  cacheBytes;
+    size_t  residentBytes = 0;
+    quint64 useCounter = 0;
+};
+
+RenderServer::RenderServer(size_t cacheBytes, QObject *parent)
+    : QObject(parent),
+      server(new QLocalServer(this))
+{
+    encoders.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+    connect(server, &QLocalServer::newConnection, this, [this]() { onNewConnection(); });
+
+    // OffscreenRenderer (QOffscreenSurface) GUI thread'de oluşturulmalı
+    renderThread = new RenderThread(*this, encoders, cacheBytes);
+    renderThread->start();
+}
+
+RenderServer::~RenderServer()
+{
+    // Kodlayıcı görevleri RenderThread üyelerini kullanır - önce onlar bitmeli
+    renderThread->stop();
+    encoders.waitForDone();
+    delete renderThread;
+}
+
+bool RenderServer::listen(const QString &name)
+{
+    // Önceki çökmüş süreçten kalan soket dosyası
+    QLocalServer::removeServer(name);
+    if (!server->listen(name)) {
+        printf("Render sunucusu dinleyemedi (%s): %s\n", name.toStdString().c_str(),
+               server->errorString().toStdString().c_str());
+        return false;
+    }
+    return true;
+}
+
+void RenderServer::onNewConnection()
+{
+    while (QLocalSocket *socket = server->nextPendingConnection()) {
+        const quint64 id = nextConnection++;
+        connections[id].socket = socket;
+        {
+            QMutexLocker lock(&sharedMutex);
+            sharedSlots[id].resize(kSharedSlots);
+        }
+
+        connect(socket, &QLocalSocket::readyRead, this, [this, id]() { onReadyRead(id); });
+        connect(socket, &QLocalSocket::disconnected, this, [this, id, socket]() {
+            renderThread->cancel(id);
+            connections.erase(id);
+            {
+                QMutexLocker lock(&sharedMutex);
+                sharedSlots.erase(id);
+            }
+            socket->deleteLater();
+            printf("Render sunucusu: bağlantı %llu kapandı\n", (unsigned long long)id);
+            fflush(stdout);
+        });
+        printf("Render sunucusu: bağlantı %llu\n", (unsigned long long)id);
+        fflush(stdout);
+    }
+}
+
+void RenderServer::onReadyRead(quint64 id)
+{
+    auto it = connections.find(id);
+    if (it == connections.end()) return;
+
+    // Satır satır JSON; bir okumada birden fazla (pipelined) istek gelebilir
+    QByteArray &buffer = it->second.buffer;
+    buffer += it->second.socket->readAll();
+    for (qsizetype nl; (nl = buffer.indexOf('\n')) >= 0;) {
+        const QByteArray line = buffer.left(nl).trimmed();
+        buffer.remove(0, nl + 1);
+        if (!line.isEmpty()) handleLine(id, line);
+    }
+}
+
+void RenderServer::handleLine(quint64 id, const QByteArray &line)
+{
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(line, &parseError);
+
+    RenderRequest request;
+    request.connection = id;
+    request.receivedNs = nowNs();
+
+    if (!doc.isObject()) {
+        RenderReply reply = errorReply(request, "Geçersiz JSON: " + parseError.errorString());
+        deliver(reply);
+        return;
+    }
+    const QJsonObject o = doc.object();
+
+    if (o.contains("release")) {
+        // İstemci shm slotunu okudu
+        releaseShared(id, o["release"].toInt(-1));
+        return;
+    }
+
+    const CameraPose defaults;
+    request.id = o["id"];
+    request.model = o["model"].toString();
+    request.pose.yaw = float(o["yaw"].toDouble(defaults.yaw));
+    request.pose.pitch = float(o["pitch"].toDouble(defaults.pitch));
+    request.pose.distance = float(o["distance"].toDouble(defaults.distance));
+    request.size = QSize(qBound(16, o["width"].toInt(1024), kMaxSide),
+                         qBound(16, o["height"].toInt(1024), kMaxSide));
+    request.raw = o["format"].toString("png") == "rgba";
+    request.sharedMemory = o["shm"].toBool(false);
+
+    if (request.model.isEmpty() || !QFileInfo(request.model).isFile()) {
+        RenderReply reply = errorReply(request, "Model bulunamadı: " + request.model);
+        deliver(reply);
+        return;
+    }
+    request.model = QFileInfo(request.model).absoluteFilePath();
+    renderThread->enqueue(std::move(request));
+}
+
+void RenderServer::post(RenderReply &&reply)
+{
+    auto shared = std::make_shared<RenderReply>(std::move(reply));
+    QMetaObject::invokeMethod(this, [this, shared]() { deliver(*shared); }, Qt::QueuedConnection);
+}
+
+RenderServer::SharedFrame RenderServer::acquireShared(quint64 connection, qsizetype bytes)
+{
+    QMutexLocker lock(&sharedMutex);
+    auto it = sharedSlots.find(connection);
+    if (it == sharedSlots.end()) return SharedFrame();   // istemci gitti
+
+    for (int i = 0; i < kSharedSlots; ++i) {
+        SharedSlot &slot = it->second[size_t(i)];
+        if (slot.busy) continue;
+
+        if (!slot.memory || slot.memory->size() < bytes) {
+            slot.memory = std::make_shared<QSharedMemory>(QString("%1-%2-%3-%4")
+                                                              .arg(defaultName())
+                                                              .arg(QCoreApplication::applicationPid())
+                                                              .arg(connection)
+                                                              .arg(++sharedSerial));
+            if (!slot.memory->create(bytes)) {
+                printf("Render sunucusu: shm oluşturulamadı: %s\n", slot.memory->errorString().toStdString().c_str());
+                slot.memory.reset();
+                return SharedFrame();
+            }
+        }
+        slot.busy = true;
+        return SharedFrame{slot.memory, i};
+    }
+    return SharedFrame();   // tüm slotlar istemcide - soket üzerinden gönderilir
+}
+
+void RenderServer::releaseShared(quint64 connection, int slot)
+{
+    QMutexLocker lock(&sharedMutex);
+    auto it = sharedSlots.find(connection);
+    if (it != sharedSlots.end() && slot >= 0 && slot < kSharedSlots)
+        it->second[size_t(slot)].busy = false;
+}
+
+void RenderServer::attachShared(RenderReply &reply, const SharedFrame &shared, qsizetype bytes)
+{
+    reply.header["shm"] = QJsonObject{{"key", shared.memory->key()}, {"slot", shared.slot}};
+    reply.header["bytes"] = double(bytes);
+    reply.frame = QImage();   // shm'yi saran kare GUI thread'e taşınmasın
+    reply.payload.clear();
+}
+
+void RenderServer::deliver(RenderReply &reply)
+{
+    auto it = connections.find(reply.connection);
+    if (it == connections.end()) return;   // istemci gitti
+    Connection &c = it->second;
+
+    QJsonObject timing = reply.header["timing"].toObject();
+    timing["total_ms"] = toMs(nowNs() - reply.receivedNs);
+    reply.header["timing"] = timing;
+
+    // Veri shm slotunda ise (üreten thread yazdı) sadece başlık gider
+    const char *data = nullptr;
+    qsizetype bytes = 0;
+    if (!reply.header.contains("shm")) {
+        data = reply.frame.isNull() ? reply.payload.constData()
+                                    : reinterpret_cast<const char*>(reply.frame.constBits());
+        bytes = reply.frame.isNull() ? reply.payload.size() : reply.frame.sizeInBytes();
+        reply.header["bytes"] = double(bytes);
+    }
+
+    c.socket->write(QJsonDocument(reply.header).toJson(QJsonDocument::Compact) + '\n');
+    if (bytes > 0)
+        c.socket->write(data, bytes);
+}
+
+int RenderServer::run(const QStringList &args)
+{
+    QCommandLineParser parser;
+    parser.addOptions({
+        {"serve", "Render sunucusu modu"},
+        {"name", "Yerel soket adı", "name", defaultName()},
+        {"cache-mb", "Yerleşik model bütçesi (MB)", "mb", "1024"},
+    });
+    if (!parser.parse(args)) {
+        fprintf(stderr, "Sunucu argüman hatası: %s\n", parser.errorText().toStdString().c_str());
+        return 2;
+    }
+
+    const size_t cacheBytes = size_t(qMax(64, parser.value("cache-mb").toInt())) << 20;
+    RenderServer renderServer(cacheBytes);
+    if (!renderServer.listen(parser.value("name"))) return 1;
+
+    printf("Render sunucusu dinliyor: %s (model bütçesi %zu MB)\n",
+           parser.value("name").toStdString().c_str(), cacheBytes >> 20);
+    fflush(stdout);
+    return QCoreApplication::exec();
+}
+
+/* ---------- test istemcisi ---------------------------------------------------- */
+namespace {
+
+bool readLine(QLocalSocket &socket, QByteArray &line)
+{
+    while (!socket.canReadLine())
+        if (!socket.waitForReadyRead(30000)) return false;
+    line = socket.readLine();
+    return true;
+}
+
+bool readExactly(QLocalSocket &socket, qint64 bytes, QByteArray &data)
+{
+    data.clear();
+    data.reserve(bytes);
+    while (data.size() < bytes) {
+        if (socket.bytesAvailable() == 0 && !socket.waitForReadyRead(30000)) return false;
+        data += socket.read(bytes - data.size());
+    }
+    return true;
+}
+
+double percentile(std::vector<double> values, double p)
+{
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, size_t(p * (values.size() - 1) + 0.5))];
+}
+
+} // namespace
+
+int RenderClient::run(const QStringList &args)
+{
+    QCommandLineParser parser;
+    parser.addOptions({
+        {"client", "Render sunucusu test istemcisi"},
+        {"name", "Yerel soket adı", "name", RenderServer::defaultName()},
+        {"requests", "Toplam istek", "n", "64"},
+        {"pipeline", "Aynı anda bekleyen en fazla istek", "n", "8"},
+        {"turntable", "Model başına ardışık yaw sayısı", "n", "8"},
+        {"size", "Çözünürlük (GxY)", "WxH", "1024x1024"},
+        {"format", "png veya rgba", "format", "png"},
+        {"shm", "Kareleri paylaşımlı bellekten al"},
+        {"out", "Kareleri bu dizine kaydet", "dir"},
+    });
+    parser.addPositionalArgument("models", "Model dosyaları");
+    if (!parser.parse(args)) {
+        fprintf(stderr, "İstemci argüman hatası: %s\n", parser.errorText().toStdString().c_str());
+        return 2;
+    }
+
+    const QStringList models = parser.positionalArguments();
+    const QStringList size = parser.value("size").split('x');
+    if (models.isEmpty() || size.size() != 2) {
+        fprintf(stderr, "Kullanım: --client [--size WxH] [--format png|rgba] [--shm] model...\n");
+        return 2;
+    }
+
+    QLocalSocket socket;
+    socket.connectToServer(parser.value("name"));
+    if (!socket.waitForConnected(3000)) {
+        fprintf(stderr, "Sunucuya bağlanılamadı: %s\n", socket.errorString().toStdString().c_str());
+        return 1;
+    }
+
+    const int total = qMax(1, parser.value("requests").toInt());
+    const int depth = qMax(1, parser.value("pipeline").toInt());
+    const int turntable = qMax(1, parser.value("turntable").toInt());
+    const QString format = parser.value("format");
+    const QString outDir = parser.value("out");
+    if (!outDir.isEmpty()) QDir().mkpath(outDir);
+
+    std::map<int, qint64> sentAt;
+    std::vector<double> latencies, renderMs, queueMs;
+    int sent = 0, received = 0, errors = 0;
+    qint64 payloadBytes = 0;
+
+    QElapsedTimer clock;
+    clock.start();
+
+    while (received < total) {
+        // Pencere dolana kadar beklemeden gönder
+        while (sent < total && sent - received < depth) {
+            const CameraPose defaults;
+            QJsonObject request;
+            request["id"] = sent;
+            request["model"] = QFileInfo(models[(sent / turntable) % models.size()]).absoluteFilePath();
+            request["yaw"] = 360.0 * (sent % turntable) / turntable;
+            request["pitch"] = defaults.pitch;
+            request["distance"] = defaults.distance;
+            request["width"] = size[0].toInt();
+            request["height"] = size[1].toInt();
+            request["format"] = format;
+            request["shm"] = parser.isSet("shm");
+            socket.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+            sentAt[sent++] = clock.nsecsElapsed();
+        }
+        socket.flush();
+
+        QByteArray line, payload;
+        if (!readLine(socket, line)) {
+            fprintf(stderr, "Sunucudan yanıt gelmedi\n");
+            return 1;
+        }
+        const QJsonObject header = QJsonDocument::fromJson(line).object();
+        const int id = header["id"].toInt(-1);
+        const qint64 bytes = qint64(header["bytes"].toDouble());
+
+        if (header.contains("shm")) {
+            const QJsonObject shmInfo = header["shm"].toObject();
+            QSharedMemory shm(shmInfo["key"].toString());
+            if (shm.attach(QSharedMemory::ReadOnly)) {
+                shm.lock();
+                if (!outDir.isEmpty())
+                    payload = QByteArray(static_cast<const char*>(shm.constData()), bytes);
+                shm.unlock();
+                shm.detach();
+            }
+            const QJsonObject release{{"release", shmInfo["slot"]}};
+            socket.write(QJsonDocument(release).toJson(QJsonDocument::Compact) + '\n');
+        } else if (bytes > 0 && !readExactly(socket, bytes, payload)) {
+            fprintf(stderr, "Kare verisi eksik (id %d)\n", id);
+            return 1;
+        }
+
+        ++received;
+        payloadBytes += bytes;
+        if (!header["ok"].toBool()) {
+            ++errors;
+            printf("İstek %d hata: %s\n", id, header["error"].toString().toStdString().c_str());
+            continue;
+        }
+
+        latencies.push_back(toMs(clock.nsecsElapsed() - sentAt[id]));
+        const QJsonObject timing = header["timing"].toObject();
+        renderMs.push_back(timing["render_ms"].toDouble());
+        queueMs.push_back(timing["queue_ms"].toDouble());
+
+        if (!outDir.isEmpty() && !payload.isEmpty()) {
+            const QString path = QString("%1/frame_%2.png").arg(outDir).arg(id, 4, 10, QChar('0'));
+            if (format == "rgba") {
+                QImage image(reinterpret_cast<const uchar*>(payload.constData()),
+                             header["width"].toInt(), header["height"].toInt(), QImage::Format_RGBA8888);
+                image.save(path);
+            } else {
+                QFile file(path);
+                if (file.open(QIODevice::WriteOnly)) file.write(payload);
+            }
+        }
+    }
+
+    const double seconds = clock.nsecsElapsed() / 1e9;
+    printf("İstemci: %d istek, %d hata, %.2f s, %.1f istek/s, %.1f MB veri\n",
+           received, errors, seconds, received / seconds, payloadBytes / (1024.0 * 1024.0));
+    printf("  gecikme ms  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f\n",
+           percentile(latencies, 0.50), percentile(latencies, 0.95),
+           percentile(latencies, 0.99), percentile(latencies, 1.0));
+    printf("  sunucu ms   render p50 %.2f  kuyruk p50 %.2f  kuyruk p95 %.2f\n",
+           percentile(renderMs, 0.50), percentile(queueMs, 0.50), percentile(queueMs, 0.95));
+    return errors == 0 ? 0 : 1;
+}
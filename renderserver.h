@@ -0,0 +1,118 @@
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QImage>
+#include <QSize>
+#include <QThreadPool>
+#include <QMutex>
+#include <map>
+#include <memory>
+#include <vector>
+#include "scenedata.h"
+
+class QLocalServer;
+class QLocalSocket;
+class QSharedMemory;
+class RenderThread;
+
+// Headless render sunucusu (QLocalServer / Unix domain socket).
+//
+// Protokol: her satır bir JSON istek, ör.
+//   {"id": 7, "model": "/x/shirt.glb", "yaw": 30, "pitch": 10, "distance": 2.5,
+//    "width": 1024, "height": 1024, "format": "png" | "rgba", "shm": true}
+// Yanıt: tek satır JSON başlık + (shm kullanılmadıysa) "bytes" kadar ham veri.
+// shm ile dönen karelerin slotu istemci okuyunca {"release": slot} ile bırakılır.
+//
+// İstekler beklemeden (pipelined) gönderilebilir. Render thread'i kuyruktaki
+// aynı modele ait istekleri tek yükleme/upload ile toplu çizer; hazırlanmış
+// modeller (paketlenmiş + AO) bellek bütçesi içinde yerleşik kalır.
+// Yanıtlar id ile eşlenir, sıra garanti edilmez.
+struct RenderRequest
+{
+    quint64    connection = 0;
+    QJsonValue id;
+    QString    model;
+    CameraPose pose;
+    QSize      size = QSize(1024, 1024);
+    bool       raw = false;            // RGBA8888 (satırlar yukarıdan aşağı) veya PNG
+    bool       sharedMemory = false;
+    qint64     receivedNs = 0;         // sunucu saatine göre
+};
+
+struct RenderReply
+{
+    quint64     connection = 0;
+    qint64      receivedNs = 0;
+    QJsonObject header;       // "shm" varsa veri slotta, sokete sadece başlık
+    QByteArray  payload;     // PNG
+    QImage      frame;       // rgba: kopyalamadan shm'ye / sokete yazılır
+};
+
+class RenderServer : public QObject
+{
+public:
+    explicit RenderServer(size_t cacheBytes = size_t(1024) << 20, QObject *parent = nullptr);
+    ~RenderServer() override;
+
+    static QString defaultName() { return "desktopviewer-render"; }
+
+    bool listen(const QString &name);
+
+    // --serve: argümanları işle, dinle, event loop'u çalıştır
+    static int run(const QStringList &args);
+
+    // Render/encoder thread'lerinden çağrılır; yanıt GUI thread'de gönderilir
+    void post(RenderReply &&reply);
+
+    // Kare verisinin yazılacağı shm slotu. Her thread'den çağrılabilir: kare
+    // üreten thread doğrudan slota yazar, GUI thread'e sadece başlık gider.
+    struct SharedFrame {
+        std::shared_ptr<QSharedMemory> memory;   // bağlantı kapansa da yazım bitene kadar yaşar
+        int slot = -1;
+    };
+    SharedFrame acquireShared(quint64 connection, qsizetype bytes);
+    void releaseShared(quint64 connection, int slot);
+    static void attachShared(RenderReply &reply, const SharedFrame &shared, qsizetype bytes);
+
+private:
+    static constexpr int kSharedSlots = 4;
+
+    struct Connection
+    {
+        QLocalSocket *socket = nullptr;
+        QByteArray    buffer;
+    };
+
+    // Slot istemci {"release"} gönderene kadar meşgul; meşgul olmayan slota
+    // istemci erişmez, bu yüzden yazım shm kilidi gerektirmez
+    struct SharedSlot
+    {
+        std::shared_ptr<QSharedMemory> memory;
+        bool busy = false;
+    };
+
+    void onNewConnection();
+    void onReadyRead(quint64 id);
+    void handleLine(quint64 id, const QByteArray &line);
+    void deliver(RenderReply &reply);
+
+    QLocalServer *server = nullptr;
+    RenderThread *renderThread = nullptr;
+    QThreadPool   encoders;
+    std::map<quint64, Connection> connections;
+    quint64       nextConnection = 1;
+
+    QMutex        sharedMutex;   // sharedSlots ve sharedSerial
+    std::map<quint64, std::vector<SharedSlot>> sharedSlots;
+    quint64       sharedSerial = 0;
+};
+
+// --client: sunucuya istek akışı gönderip gecikme istatistiği basar (test aracı)
+namespace RenderClient
+{
+    int run(const QStringList &args);
+}
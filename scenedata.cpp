@@ -0,0 +1,491 @@
+#include "scenedata.h"
+#include "aobake.h"
+#include "mmapiosystem.h"
+#include "objloader.h"
+#include <QFileInfo>
+#include <QByteArray>
+#include <QtMath>
+#include <algorithm>
+
+namespace {
+
+// Düğüm grafiğinde bir mesh kullanımı (PreTransformVertices'in kopyalayarak düzleştirdiği)
+struct MeshInstance
+{
+    unsigned    mesh;
+    aiMatrix4x4 transform;   // kök düğüme göre birikmiş dönüşüm
+};
+
+void collectNode(const aiNode *node, const aiMatrix4x4 &parent, std::vector<MeshInstance> &out)
+{
+    const aiMatrix4x4 global = parent * node->mTransformation;
+    for (unsigned i = 0; i < node->mNumMeshes; ++i)
+        out.push_back({node->mMeshes[i], global});
+    for (unsigned i = 0; i < node->mNumChildren; ++i)
+        collectNode(node->mChildren[i], global, out);
+}
+
+std::vector<MeshInstance> collectInstances(const aiScene *scene)
+{
+    auto usable = [scene](unsigned mesh) {
+        return mesh < scene->mNumMeshes && scene->mMeshes[mesh] && scene->mMeshes[mesh]->mNumVertices > 0;
+    };
+
+    std::vector<MeshInstance> instances;
+    if (scene->mRootNode) collectNode(scene->mRootNode, aiMatrix4x4(), instances);
+    instances.erase(std::remove_if(instances.begin(), instances.end(),
+                                   [&](const MeshInstance &i) { return !usable(i.mesh); }),
+                    instances.end());
+
+    // Düğümsüz (elle kurulmuş) sahne: her mesh bir kez, birim dönüşümle
+    if (instances.empty()) {
+        for (unsigned m = 0; m < scene->mNumMeshes; ++m)
+            if (usable(m)) instances.push_back({m, aiMatrix4x4()});
+    }
+    return instances;
+}
+
+void appendVertices(const aiMesh *m, const aiMatrix4x4 &transform, std::vector<float> &verts)
+{
+    const bool identity = transform.IsIdentity();
+    aiMatrix3x3 normalMatrix(transform);
+    normalMatrix.Inverse().Transpose();
+
+    // Vertex data: position + texCoord + normal
+    for (unsigned i = 0; i < m->mNumVertices; ++i) {
+        const aiVector3D p = identity ? m->mVertices[i] : transform * m->mVertices[i];
+        verts.push_back(p.x);
+        verts.push_back(p.y);
+        verts.push_back(p.z);
+
+        if (m->mTextureCoords[0]) {
+            // 0-1 aralığına sığdır ve V'yi çevir (uploadAllMeshes ile aynı)
+            float u = qBound(0.0f, m->mTextureCoords[0][i].x, 1.0f);
+            float v = qBound(0.0f, m->mTextureCoords[0][i].y, 1.0f);
+            verts.push_back(u);
+            verts.push_back(1.0f - v);
+        } else {
+            verts.push_back(0.5f);
+            verts.push_back(0.5f);
+        }
+
+        if (m->mNormals) {
+            aiVector3D n = m->mNormals[i];
+            if (!identity) (n = normalMatrix * n).NormalizeSafe();
+            verts.push_back(n.x);
+            verts.push_back(n.y);
+            verts.push_back(n.z);
+        } else {
+            verts.push_back(0.0f);
+            verts.push_back(1.0f);
+            verts.push_back(0.0f);
+        }
+    }
+}
+
+void appendIndices(const aiMesh *m, unsigned vertexOffset, bool flipWinding, std::vector<unsigned> &idx)
+{
+    // Sadece üçgen face'leri kabul et. Aynalanmış instance'da sarım yönü ters döner.
+    for (unsigned i = 0; i < m->mNumFaces; ++i) {
+        const aiFace &face = m->mFaces[i];
+        if (face.mNumIndices != 3) continue;
+        idx.push_back(face.mIndices[0] + vertexOffset);
+        idx.push_back(face.mIndices[flipWinding ? 2 : 1] + vertexOffset);
+        idx.push_back(face.mIndices[flipWinding ? 1 : 2] + vertexOffset);
+    }
+}
+
+void appendMatrix(const aiMatrix4x4 &m, std::vector<float> &out)
+{
+    // aiMatrix4x4 satır öncelikli, GL sütun öncelikli bekler
+    for (unsigned c = 0; c < 4; ++c)
+        for (unsigned r = 0; r < 4; ++r)
+            out.push_back(m[r][c]);
+}
+
+} // namespace
+
+unsigned SceneData::importFlags()
+{
+    // PreTransformVertices yok: düğüm hiyerarşisi korunur, tekrar eden mesh'ler
+    // kopyalanmaz. Düzleştirme packMeshes'te, instancing buildInstancing'de.
+    return aiProcess_Triangulate |
+           aiProcess_GenSmoothNormals |
+           aiProcess_JoinIdenticalVertices |
+           aiProcess_FlipUVs; // UV'leri çevir - ÖNEMLİ!
+}
+
+bool SceneData::loadScene(Assimp::Importer &importer, const QString &filePath, PackedScene &out,
+                          QStringList *dependencies)
+{
+    // Büyük OBJ'ler için paralel hızlı yol; başarısızsa Assimp
+    if (ObjLoader::isEnabledFor(filePath) && ObjLoader::load(filePath, out, dependencies)) {
+        AmbientOcclusion::loadOrBake(out, filePath);
+        return true;
+    }
+
+    MappedIOSystem::install(importer, filePath);
+    const aiScene *scene = importer.ReadFile(filePath.toStdString(), importFlags());
+    if (!scene || !scene->HasMeshes()) {
+        printf("Model yükleme hatası (%s): %s\n",
+               filePath.toStdString().c_str(), importer.GetErrorString());
+        return false;
+    }
+
+    computeBounds(scene, out);
+    packMeshes(scene, out);
+    AmbientOcclusion::loadOrBake(out, filePath);
+    out.texture = findDiffuseTexture(scene, filePath);
+    if (dependencies) dependencies->append(externalTexturePaths(scene, filePath));
+    return !out.isEmpty();
+}
+
+void SceneData::packMeshes(const aiScene *scene, PackedScene &out)
+{
+    interleaveVertices(scene, out.verts);
+    extractIndices(scene, out.idx, &out.meshes);
+    // Vertex sırası düğüm gezinme sırası - eski (PreTransformVertices) cache kayıtlarıyla karışmasın
+    out.cacheVariant = "nodes";
+}
+
+void SceneData::interleaveVertices(const aiScene *scene, std::vector<float> &verts)
+{
+    verts.clear();
+    if (!scene) return;
+
+    const std::vector<MeshInstance> instances = collectInstances(scene);
+
+    // Kapasiteyi baştan ayır - büyük modellerde tekrar tekrar büyümesin
+    size_t totalVerts = 0;
+    for (const MeshInstance &inst : instances)
+        totalVerts += scene->mMeshes[inst.mesh]->mNumVertices;
+    verts.reserve(totalVerts * PackedScene::kFloatsPerVertex);
+
+    for (const MeshInstance &inst : instances)
+        appendVertices(scene->mMeshes[inst.mesh], inst.transform, verts);
+}
+
+void SceneData::extractIndices(const aiScene *scene, std::vector<unsigned> &idx,
+                               std::vector<PackedScene::MeshRange> *meshes)
+{
+    idx.clear();
+    if (meshes) meshes->clear();
+    if (!scene) return;
+
+    const std::vector<MeshInstance> instances = collectInstances(scene);
+
+    size_t totalFaces = 0;
+    for (const MeshInstance &inst : instances)
+        totalFaces += scene->mMeshes[inst.mesh]->mNumFaces;
+    idx.reserve(totalFaces * 3);
+
+    unsigned vertexOffset = 0;
+    for (const MeshInstance &inst : instances) {
+        const unsigned mIdx = inst.mesh;
+        const aiMesh *m = scene->mMeshes[mIdx];
+
+        PackedScene::MeshRange range;
+        range.firstTriangle = unsigned(idx.size() / 3);
+        range.sourceMesh = mIdx;
+
+        appendIndices(m, vertexOffset, inst.transform.Determinant() < 0.0f, idx);
+
+        if (meshes) {
+            range.triangleCount = unsigned(idx.size() / 3) - range.firstTriangle;
+            range.name = QString::fromUtf8(m->mName.C_Str());
+            if (m->mMaterialIndex < scene->mNumMaterials) {
+                aiString matName;
+                if (scene->mMaterials[m->mMaterialIndex]->Get(AI_MATKEY_NAME, matName) == AI_SUCCESS)
+                    range.materialName = QString::fromUtf8(matName.C_Str());
+            }
+            meshes->push_back(range);
+        }
+
+        vertexOffset += m->mNumVertices;
+    }
+}
+
+void SceneData::computeBounds(const aiScene *scene, PackedScene &out)
+{
+    if (!scene || scene->mNumMeshes == 0) return;
+
+    // Her mesh'in yerel AABB'si bir kez; instance'larda sadece 8 köşe dönüştürülür
+    std::vector<aiVector3D> localMin(scene->mNumMeshes), localMax(scene->mNumMeshes);
+    std::vector<bool> measured(scene->mNumMeshes, false);
+
+    bool first = true;
+    aiVector3D mn, mx;
+
+    for (const MeshInstance &inst : collectInstances(scene)) {
+        const aiMesh *mesh = scene->mMeshes[inst.mesh];
+        if (!measured[inst.mesh]) {
+            aiVector3D lo = mesh->mVertices[0], hi = mesh->mVertices[0];
+            for (unsigned i = 1; i < mesh->mNumVertices; ++i) {
+                const aiVector3D &v = mesh->mVertices[i];
+                lo.x = qMin(lo.x, v.x); hi.x = qMax(hi.x, v.x);
+                lo.y = qMin(lo.y, v.y); hi.y = qMax(hi.y, v.y);
+                lo.z = qMin(lo.z, v.z); hi.z = qMax(hi.z, v.z);
+            }
+            localMin[inst.mesh] = lo;
+            localMax[inst.mesh] = hi;
+            measured[inst.mesh] = true;
+        }
+
+        const aiVector3D &lo = localMin[inst.mesh], &hi = localMax[inst.mesh];
+        for (int corner = 0; corner < 8; ++corner) {
+            const aiVector3D v = inst.transform * aiVector3D(corner & 1 ? hi.x : lo.x,
+                                                             corner & 2 ? hi.y : lo.y,
+                                                             corner & 4 ? hi.z : lo.z);
+            if (first) {
+                mn = mx = v;
+                first = false;
+            } else {
+                mn.x = qMin(mn.x, v.x); mx.x = qMax(mx.x, v.x);
+                mn.y = qMin(mn.y, v.y); mx.y = qMax(mx.y, v.y);
+                mn.z = qMin(mn.z, v.z); mx.z = qMax(mx.z, v.z);
+            }
+        }
+    }
+
+    out.boundingMin = QVector3D(mn.x, mn.y, mn.z);
+    out.boundingMax = QVector3D(mx.x, mx.y, mx.z);
+
+    // Model merkezi ve yarıçapı
+    out.center = (out.boundingMin + out.boundingMax) * 0.5f;
+    QVector3D size = out.boundingMax - out.boundingMin;
+    out.radius = qMax(qMax(size.x(), size.y()), size.z()) * 0.6f;
+}
+
+void SceneData::buildInstancing(const aiScene *scene, PackedScene &out)
+{
+    out.instanced = PackedScene::Instanced();
+    if (!scene) return;
+
+    const std::vector<MeshInstance> instances = collectInstances(scene);
+
+    // Her mesh'in kullanımları (düğüm sırasıyla) ve düzleştirilmiş vertex offset'leri
+    std::vector<std::vector<size_t>> usesOf(scene->mNumMeshes);
+    std::vector<unsigned> flatFirst(instances.size());
+    unsigned flatVertex = 0;
+    bool repeated = false;
+    for (size_t k = 0; k < instances.size(); ++k) {
+        std::vector<size_t> &uses = usesOf[instances[k].mesh];
+        uses.push_back(k);
+        repeated |= uses.size() > 1;
+        flatFirst[k] = flatVertex;
+        flatVertex += scene->mMeshes[instances[k].mesh]->mNumVertices;
+    }
+    if (!repeated) return;   // düzleştirilmiş düzen zaten kopyasız
+
+    PackedScene::Instanced &inst = out.instanced;
+    const aiMatrix4x4 identity;
+
+    // 1. Tek kullanılan mesh'ler dünya uzayında birleşik: tek instance, tek çizim
+    PackedScene::Instanced::Batch single;
+    for (size_t k = 0; k < instances.size(); ++k) {
+        const MeshInstance &mi = instances[k];
+        if (usesOf[mi.mesh].size() != 1) continue;
+
+        const aiMesh *m = scene->mMeshes[mi.mesh];
+        const unsigned base = unsigned(inst.vertexCount());
+        inst.sources.push_back({flatFirst[k], base, m->mNumVertices});
+        appendVertices(m, mi.transform, inst.verts);
+        appendIndices(m, base, mi.transform.Determinant() < 0.0f, inst.idx);
+    }
+    single.indexCount = unsigned(inst.idx.size());
+    single.instanceCount = 1;
+    if (single.indexCount > 0) {
+        inst.batches.push_back(single);
+        appendMatrix(identity, inst.transforms);
+    }
+
+    // 2. Tekrar eden mesh'ler yerel uzayda bir kez, kullanım başına bir matris
+    int instanceCount = 0;
+    for (size_t k = 0; k < instances.size(); ++k) {
+        const std::vector<size_t> &uses = usesOf[instances[k].mesh];
+        if (uses.size() < 2 || uses.front() != k) continue;   // ilk görülüşte bir kez
+
+        const aiMesh *m = scene->mMeshes[instances[k].mesh];
+        const unsigned base = unsigned(inst.vertexCount());
+
+        PackedScene::Instanced::Batch batch;
+        batch.firstIndex = unsigned(inst.idx.size());
+        batch.firstInstance = unsigned(inst.transforms.size() / 16);
+        batch.instanceCount = unsigned(uses.size());
+
+        appendVertices(m, identity, inst.verts);
+        appendIndices(m, base, false, inst.idx);
+        batch.indexCount = unsigned(inst.idx.size()) - batch.firstIndex;
+
+        for (size_t use : uses) {
+            appendMatrix(instances[use].transform, inst.transforms);
+            inst.sources.push_back({flatFirst[use], base, m->mNumVertices});
+        }
+        inst.batches.push_back(batch);
+        instanceCount += int(uses.size());
+    }
+
+    printf("Instancing: %d tekrar eden mesh, %d instance; vertex %u -> %d\n",
+           int(inst.batches.size()) - (single.indexCount > 0 ? 1 : 0), instanceCount,
+           flatVertex, inst.vertexCount());
+}
+
+void SceneData::resolveInstanceAo(PackedScene &scene)
+{
+    PackedScene::Instanced &inst = scene.instanced;
+    inst.ao.clear();
+    if (inst.isEmpty() || scene.ao.size() != size_t(scene.vertexCount())) return;
+
+    // Aynı yerel vertex'i paylaşan instance'ların örtülme ortalaması
+    std::vector<float> weight(size_t(inst.vertexCount()), 0.0f);
+    inst.ao.assign(weight.size(), 0.0f);
+    for (const PackedScene::Instanced::Source &src : inst.sources) {
+        for (unsigned v = 0; v < src.vertexCount; ++v) {
+            inst.ao[src.firstVertex + v] += scene.ao[src.flatFirstVertex + v];
+            weight[src.firstVertex + v] += 1.0f;
+        }
+    }
+    for (size_t v = 0; v < weight.size(); ++v)
+        inst.ao[v] = weight[v] > 0.0f ? inst.ao[v] / weight[v] : 1.0f;
+}
+
+void SceneData::flattenInstances(PackedScene &scene)
+{
+    const PackedScene::Instanced &inst = scene.instanced;
+    const size_t stride = PackedScene::kFloatsPerVertex;
+    const bool hasAo = inst.ao.size() == size_t(inst.vertexCount());
+    scene.verts.clear();
+    scene.idx.clear();
+    scene.ao.clear();
+
+    // Batch'in kullandığı her yerel vertex instance başına bir kez kopyalanır
+    std::vector<unsigned> remap(size_t(inst.vertexCount()));
+    std::vector<unsigned> stamp(remap.size(), ~0u);
+    unsigned pass = 0;
+    for (const PackedScene::Instanced::Batch &batch : inst.batches) {
+        for (unsigned i = 0; i < batch.instanceCount; ++i, ++pass) {
+            // transforms sütun öncelikli, QMatrix4x4(float*) satır öncelikli okur
+            const QMatrix4x4 model = QMatrix4x4(inst.transforms.data() + size_t(batch.firstInstance + i) * 16).transposed();
+            const QMatrix3x3 normalMatrix = model.normalMatrix();
+            for (unsigned k = 0; k < batch.indexCount; ++k) {
+                const unsigned v = inst.idx[batch.firstIndex + k];
+                if (stamp[v] != pass) {
+                    stamp[v] = pass;
+                    remap[v] = unsigned(scene.verts.size() / stride);
+                    const float *src = inst.verts.data() + v * stride;
+                    const QVector3D p = model.map(QVector3D(src[0], src[1], src[2]));
+                    QVector3D n;
+                    for (int r = 0; r < 3; ++r)
+                        n[r] = normalMatrix(r, 0) * src[5] + normalMatrix(r, 1) * src[6] + normalMatrix(r, 2) * src[7];
+                    n.normalize();
+                    scene.verts.insert(scene.verts.end(), { p.x(), p.y(), p.z(), src[3], src[4], n.x(), n.y(), n.z() });
+                    if (hasAo) scene.ao.push_back(inst.ao[v]);
+                }
+                scene.idx.push_back(remap[v]);
+            }
+        }
+    }
+}
+
+QImage SceneData::decodeEmbeddedTexture(const aiTexture *aiTex)
+{
+    if (!aiTex) return QImage();
+
+    QImage image;
+    // Compressed texture (PNG, JPG vs.)
+    if (aiTex->mHeight == 0) {
+        const QByteArray data = QByteArray::fromRawData((const char*)aiTex->pcData, aiTex->mWidth);
+        image.loadFromData(data);
+    }
+    // Uncompressed texture (raw RGBA data) - aiTexture'a bağlı kalmasın diye kopyala
+    else {
+        image = QImage((const uchar*)aiTex->pcData,
+                       aiTex->mWidth, aiTex->mHeight,
+                       QImage::Format_RGBA8888).copy();
+    }
+    return image;
+}
+
+QImage SceneData::toGLImage(const QImage &image)
+{
+    // OpenGL formatına çevir - Y eksenini çevir
+    return image.convertToFormat(QImage::Format_RGBA8888).mirrored();
+}
+
+QImage SceneData::findDiffuseTexture(const aiScene *scene, const QString &filePath)
+{
+    if (!scene) return QImage();
+
+    // 1. Önce embedded texture'ları dene (loadModel ile aynı sıra)
+    for (unsigned int i = 0; i < scene->mNumTextures; i++) {
+        QImage image = decodeEmbeddedTexture(scene->mTextures[i]);
+        if (!image.isNull()) return toGLImage(image);
+    }
+
+    // 2. Material texture referanslarını dene
+    for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
+        aiMaterial *mat = scene->mMaterials[i];
+
+        for (unsigned int j = 0; j < mat->GetTextureCount(aiTextureType_DIFFUSE); j++) {
+            aiString texPath;
+            if (mat->GetTexture(aiTextureType_DIFFUSE, j, &texPath) != AI_SUCCESS) continue;
+
+            QImage image;
+            if (texPath.C_Str()[0] == '*') {
+                int texIndex = atoi(texPath.C_Str() + 1);
+                if (texIndex < (int)scene->mNumTextures)
+                    image = decodeEmbeddedTexture(scene->mTextures[texIndex]);
+            } else {
+                image.load(QFileInfo(filePath).absolutePath() + "/" + QString(texPath.C_Str()));
+            }
+            if (!image.isNull()) return toGLImage(image);
+        }
+    }
+    return QImage();
+}
+
+QStringList SceneData::externalTexturePaths(const aiScene *scene, const QString &filePath)
+{
+    QStringList paths;
+    if (!scene) return paths;
+
+    for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
+        aiMaterial *mat = scene->mMaterials[i];
+        for (unsigned int j = 0; j < mat->GetTextureCount(aiTextureType_DIFFUSE); j++) {
+            aiString texPath;
+            if (mat->GetTexture(aiTextureType_DIFFUSE, j, &texPath) != AI_SUCCESS) continue;
+            if (texPath.C_Str()[0] == '*') continue;   // embedded
+
+            const QString full = QFileInfo(filePath).absolutePath() + "/" + QString(texPath.C_Str());
+            if (QFileInfo::exists(full) && !paths.contains(full)) paths.append(full);
+        }
+    }
+    return paths;
+}
+
+QMatrix4x4 SceneData::orbitView(float yaw, float pitch, float distance)
+{
+    const float ry = qDegreesToRadians(yaw);
+    const float rp = qDegreesToRadians(pitch);
+
+    // Kamera pozisyonu
+    QVector3D eye(distance * qCos(rp) * qSin(ry),
+                  distance * qSin(rp),
+                  distance * qCos(rp) * qCos(ry));
+
+    // Sahne merkezine bak (0,0,0) - model merkezi değil
+    QMatrix4x4 view;
+    view.lookAt(eye, QVector3D(0, 0, 0), QVector3D(0, 1, 0));
+    return view;
+}
+
+QMatrix4x4 SceneData::framingModel(const QVector3D &boundingMin, const QVector3D &boundingMax)
+{
+    // Modeli hem X/Z'de merkeze, hem de Y'de zemin seviyesine getir
+    QVector3D adjustedCenter = (boundingMin + boundingMax) * 0.5f;
+    adjustedCenter.setY(boundingMin.y() + (boundingMax.y() - boundingMin.y()) * 0.3f);
+
+    QMatrix4x4 model;
+    model.translate(-adjustedCenter);
+    return model;
+}
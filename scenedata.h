@@ -0,0 +1,124 @@
+#pragma once
+#include <QString>
+#include <QImage>
+#include <QStringList>
+#include <QVector3D>
+#include <QMatrix4x4>
+#include <vector>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+
+// GPU'ya gidecek hazır (paketlenmiş) sahne verisi.
+// Vertex düzeni uploadAllMeshes ile aynı: position(3) + texCoord(2) + normal(3)
+struct PackedScene
+{
+    static constexpr int kFloatsPerVertex = 8;
+
+    // Birleşik üçgen listesinde kaynak aiMesh'in kapladığı aralık (picking için)
+    struct MeshRange {
+        unsigned firstTriangle = 0;
+        unsigned triangleCount = 0;
+        unsigned sourceMesh = 0;     // scene->mMeshes index'i
+        QString  name;
+        QString  materialName;
+    };
+
+    std::vector<float>    verts;
+    std::vector<unsigned> idx;
+
+    QVector3D boundingMin, boundingMax;
+    QVector3D center;
+    float     radius = 1.0f;
+
+    std::vector<MeshRange> meshes;
+    std::vector<float>    ao;   // vertex başına ambient occlusion (0-1), boşsa 1 kabul edilir
+
+    QImage texture;          // RGBA8888, OpenGL için çevrilmiş (mirrored) - yoksa null
+
+    // Hiyerarşi korunarak import edilen sahnelerde GPU düzeni: tekrar eden mesh'ler
+    // (düğme, perçin, bağcık deliği) yerel uzayda bir kez, her kullanımı bir instance
+    // matrisi. Boşsa verts/idx doğrudan çizilir. Düzleştirilmiş verts/idx BVH, AO,
+    // picking ve offscreen render için her durumda doludur.
+    struct Instanced {
+        struct Batch {
+            unsigned firstIndex = 0;
+            unsigned indexCount = 0;
+            unsigned firstInstance = 0;
+            unsigned instanceCount = 0;
+        };
+        // Düzleştirilmiş vertex aralığı -> instanced vertex aralığı (AO aktarımı için)
+        struct Source {
+            unsigned flatFirstVertex;
+            unsigned firstVertex;
+            unsigned vertexCount;
+        };
+
+        std::vector<float>    verts;        // kFloatsPerVertex düzeni
+        std::vector<unsigned> idx;
+        std::vector<float>    ao;           // resolveInstanceAo ile doldurulur
+        std::vector<float>    transforms;   // instance başına sütun öncelikli mat4
+        std::vector<Batch>    batches;
+        std::vector<Source>   sources;
+
+        int  vertexCount() const { return int(verts.size() / kFloatsPerVertex); }
+        bool isEmpty()     const { return batches.empty(); }
+    };
+    Instanced instanced;
+
+    // Farklı yükleyiciler (Assimp / hızlı OBJ) farklı vertex sırası üretir;
+    // AO/BVH cache kayıtları karışmasın diye cache türüne eklenir
+    QString cacheVariant;
+    QString cacheKind(const QString &kind) const
+    {
+        return cacheVariant.isEmpty() ? kind : kind + "-" + cacheVariant;
+    }
+
+    int vertexCount()   const { return int(verts.size() / kFloatsPerVertex); }
+    int triangleCount() const { return int(idx.size() / 3); }
+    bool isEmpty()      const { return verts.empty() || idx.empty(); }
+};
+
+// Kamera pozu - resetCamera/updateView'daki yaw/pitch/distance ile aynı anlamda
+struct CameraPose
+{
+    float yaw      = 45.0f;
+    float pitch    = 10.0f;
+    float distance = 2.5f;   // modelRadius katı (resetCamera: modelRadius * 2.5)
+};
+
+// Widget'tan bağımsız (GL gerektirmeyen) yükleme adımları.
+// GLViewport, batch renderer ve diğer araçlar aynı kodu kullanır.
+namespace SceneData
+{
+    unsigned importFlags();
+
+    // Assimp ile oku + paketle + bounding box + AO + texture. importer sahneyi sahiplenir.
+    // dependencies: diskten okunan yardımcı dosyalar (.mtl, dış texture'lar)
+    bool loadScene(Assimp::Importer &importer, const QString &filePath, PackedScene &out,
+                   QStringList *dependencies = nullptr);
+
+    void packMeshes(const aiScene *scene, PackedScene &out);
+    void interleaveVertices(const aiScene *scene, std::vector<float> &verts);
+    void extractIndices(const aiScene *scene, std::vector<unsigned> &idx,
+                        std::vector<PackedScene::MeshRange> *meshes = nullptr);
+    // Düğüm dönüşümleri uygulanmış instance AABB'lerinin birleşimi
+    void computeBounds(const aiScene *scene, PackedScene &out);
+
+    // Birden fazla düğümde kullanılan mesh varsa out.instanced'ı doldurur
+    void buildInstancing(const aiScene *scene, PackedScene &out);
+    // AO düzleştirilmiş vertex'lerde hesaplanır; tekrar eden mesh'lere instance ortalaması
+    void resolveInstanceAo(PackedScene &scene);
+    // scene.instanced'ı dünya uzayına açar: verts/idx/ao instance başına kopyalanır
+    void flattenInstances(PackedScene &scene);
+
+    QImage decodeEmbeddedTexture(const aiTexture *aiTex);
+    QImage toGLImage(const QImage &image);
+    QImage findDiffuseTexture(const aiScene *scene, const QString &filePath);
+    // Diffuse texture olarak referans verilen ve diskte bulunan dış dosyalar
+    QStringList externalTexturePaths(const aiScene *scene, const QString &filePath);
+
+    // Kamera matrisleri (updateView / resetCamera ile aynı hesap)
+    QMatrix4x4 orbitView(float yaw, float pitch, float distance);
+    QMatrix4x4 framingModel(const QVector3D &boundingMin, const QVector3D &boundingMax);
+}
@@ -0,0 +1,38 @@
+#include "shaders.h"
+
+// Texture'lı vertex shader
+const char *const Shaders::vertex =
+    "#version 330 core\n"
+    "layout(location=0) in vec3 pos;"
+    "layout(location=1) in vec2 texCoord;"
+    "layout(location=2) in vec3 normal;"
+    "layout(location=3) in float ao;"      // import'ta hesaplanan AO (yoksa 1.0)
+    "layout(location=4) in mat4 instance;" // instance dönüşümü (instancing yoksa birim matris)
+    "layout(location=8) in mat3 instanceNormal;" // ters-devrik 3x3; ölçek eşit değilse normaller eğilmesin
+    "uniform mat4 mvp;"
+    "out vec2 TexCoord;"
+    "out vec3 Normal;"
+    "out float Ao;"
+    "void main(){"
+    "    gl_Position = mvp * instance * vec4(pos, 1.0);"
+    "    TexCoord = texCoord;"
+    "    Normal = instanceNormal * normal;"
+    "    Ao = ao;"
+    "}";
+
+// Texture'lı fragment shader
+const char *const Shaders::fragment =
+    "#version 330 core\n"
+    "in vec2 TexCoord;"
+    "in float Ao;"
+    "out vec4 frag;"
+    "uniform sampler2D ourTexture;"
+    "uniform bool hasTexture;"
+    "void main(){"
+    "    if(hasTexture) {"
+    "        frag = texture(ourTexture, TexCoord);" // Sadece texture
+    "    } else {"
+    "        frag = vec4(0.7, 0.7, 0.7, 1.0);"     // Gri renk
+    "    }"
+    "    frag.rgb *= mix(0.25, 1.0, Ao);"             // Kıvrım ve dikişleri koyulaştır
+    "}";
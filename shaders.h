@@ -0,0 +1,8 @@
+#pragma once
+
+// GLViewport ve offscreen renderer'ın ortak kullandığı shader kaynakları
+namespace Shaders
+{
+    extern const char *const vertex;
+    extern const char *const fragment;
+}